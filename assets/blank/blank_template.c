@@ -47,4 +47,6 @@ void minigame_loop(float deltatime)
 void minigame_cleanup()
 {
 
-}
\ No newline at end of file
+}
+
+MINIGAME_INTERFACE(minigame_def, minigame_init, minigame_fixedloop, minigame_loop, minigame_cleanup);
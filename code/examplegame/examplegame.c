@@ -11,11 +11,6 @@ the game jam.
 
 #define FONT_TEXT           1
 
-#define COUNTDOWN_DELAY     3.0f
-#define GO_DELAY            1.0f
-#define WIN_DELAY           5.0f
-#define WIN_SHOW_DELAY      2.0f
-
 #define POINTS_TO_WIN       150
 #define POINTS_PER_PRESS    6
 
@@ -44,33 +39,16 @@ const MinigameDef minigame_def = {
 
 rdpq_font_t *font;
 
+CoreText text_players[MAXPLAYERS];
+
 uint32_t player_points[MAXPLAYERS];
 uint32_t ai_press_timer[MAXPLAYERS];
 
-float countdown_timer;
-bool is_ending;
-float end_timer;
-
-wav64_t sfx_start;
-wav64_t sfx_countdown;
-wav64_t sfx_stop;
-wav64_t sfx_winner;
-
 bool has_player_won(PlyNum player)
 {
     return player_points[player] >= POINTS_TO_WIN;
 }
 
-bool is_countdown()
-{
-    return countdown_timer > 0.0f;
-}
-
-bool can_control()
-{
-    return !(is_ending || is_countdown());
-}
-
 uint32_t ai_get_ticks_until_next_press()
 {
     const float min_ticks[] = { 2.8f, 2.4f, 2.0f };   // Minimum delay in ticks by difficulty
@@ -78,7 +56,7 @@ uint32_t ai_get_ticks_until_next_press()
 
     float random = (float)rand() / RAND_MAX;
 
-    int diff = core_get_aidifficulty();
+    int diff = core_frame.aidifficulty;
     return min_ticks[diff] + random * (max_ticks[diff] - min_ticks[diff]);
 }
 
@@ -89,7 +67,6 @@ uint32_t ai_get_ticks_until_next_press()
 
 void minigame_init()
 {
-    display_init(RESOLUTION_320x240, DEPTH_16_BPP, 3, GAMMA_NONE, FILTERS_RESAMPLE);
     font = rdpq_font_load_builtin(FONT_BUILTIN_DEBUG_VAR);
     rdpq_text_register_font(FONT_TEXT, font);
 
@@ -99,11 +76,8 @@ void minigame_init()
         ai_press_timer[i] = ai_get_ticks_until_next_press();
     }
 
-    countdown_timer = COUNTDOWN_DELAY;
-    wav64_open(&sfx_start, "rom:/core/Start.wav64");
-    wav64_open(&sfx_countdown, "rom:/core/Countdown.wav64");
-    wav64_open(&sfx_stop, "rom:/core/Stop.wav64");
-    wav64_open(&sfx_winner, "rom:/core/Winner.wav64");
+    // The core handles the countdown, the winner announcement and their sounds
+    core_round_start(NULL);
 }
 
 
@@ -117,33 +91,14 @@ void minigame_init()
 
 void minigame_fixedloop(float deltatime)
 {
-    bool couldcontrol = can_control();
-    if (countdown_timer > -GO_DELAY)
-    {
-        float prevtime = countdown_timer;
-        countdown_timer -= deltatime;
-        if ((int)prevtime != (int)countdown_timer && countdown_timer >= 0)
-            wav64_play(&sfx_countdown, 31);
-    }
-
-    if (is_ending) {
-        float prevendtime = end_timer;
-        end_timer += deltatime;
-        if ((int)prevendtime != (int)end_timer && (int)end_timer == WIN_SHOW_DELAY)
-            wav64_play(&sfx_winner, 31);
-        if (end_timer > WIN_DELAY) minigame_end();
-    }
-
-    if (!can_control()) return;
-    if (!couldcontrol && can_control())
-        wav64_play(&sfx_start, 31);
+    if (!core_round_can_control()) return;
 
     for (size_t i = 0; i < MAXPLAYERS; i++)
     {
         // Subtract "point drain" for all players at fixed rate
         if (player_points[i] > 0) player_points[i] -= 1;
 
-        if (i < core_get_playercount()) continue;
+        if (i < core_frame.playercount) continue;
 
         // For AI players, wait for a random number of ticks until the next A press
         ai_press_timer[i] -= 1;
@@ -154,14 +109,15 @@ void minigame_fixedloop(float deltatime)
     }
 
     // Check if anyone has won
+    bool anyone_won = false;
     for (size_t i = 0; i < MAXPLAYERS; i++)
     {
         if (has_player_won(i)) {
             core_set_winner(i);
-            is_ending = true;
-            wav64_play(&sfx_stop, 31);
+            anyone_won = true;
         }
     }
+    if (anyone_won) core_round_finish();
 }
 
 
@@ -173,13 +129,12 @@ void minigame_fixedloop(float deltatime)
 
 void minigame_loop(float deltatime)
 {
-    if (can_control()) {
+    if (core_round_can_control()) {
         // Handle button presses of human players in variable step loop so the input feels more responsive
-        for (size_t i = 0; i < core_get_playercount(); i++)
+        for (size_t i = 0; i < core_frame.playercount; i++)
         {
             // For human players, check if the physical A button on the controller was pressed
-            joypad_buttons_t btn = joypad_get_buttons_pressed(core_get_playercontroller(i));
-            if (btn.a) player_points[i] += POINTS_PER_PRESS;
+            if (core_input_get(i)->pressed.a) player_points[i] += POINTS_PER_PRESS;
         }
     }
 
@@ -201,7 +156,7 @@ void minigame_loop(float deltatime)
 
         // Draw player names
         rdpq_set_mode_standard();
-        rdpq_text_printf(NULL, FONT_BUILTIN_DEBUG_MONO, xcur, ycur, "Player %d", i+1);
+        core_text_printf(&text_players[i], NULL, FONT_BUILTIN_DEBUG_MONO, xcur, ycur, "Player %d", i+1);
         ycur += 4;
         
         // Draw power bars
@@ -214,23 +169,8 @@ void minigame_loop(float deltatime)
         rdpq_fill_rectangle(xcur, ycur, xcur+width, ycur+POWERBAR_HEIGHT);
     }
 
-    rdpq_set_mode_standard();    
-
-    if (is_countdown()) {
-        // Draw countdown
-        rdpq_text_printf(NULL, FONT_BUILTIN_DEBUG_MONO, 155, 100, "%d", (int)ceilf(countdown_timer));
-    } else if (countdown_timer > -GO_DELAY) {
-        // For a short time after countdown is over, draw "GO!"
-        rdpq_text_print(NULL, FONT_BUILTIN_DEBUG_MONO, 150, 100, "GO!");
-    } else if (is_ending && end_timer >= WIN_SHOW_DELAY) {
-        // Draw winner announcement (There might be multiple winners)
-        int ycur = 100;
-        for (size_t i = 0; i < MAXPLAYERS; i++)
-        {
-            if (!has_player_won(i)) continue;
-            ycur += rdpq_text_printf(NULL, FONT_BUILTIN_DEBUG_MONO, 120, ycur, "Player %d wins!\n", i+1).advance_y;
-        }
-    }
+    // Draw the countdown, "GO!" or the winner announcement
+    core_round_draw_hud(FONT_BUILTIN_DEBUG_MONO);
 
     rdpq_detach_show();
 }
@@ -243,11 +183,11 @@ void minigame_loop(float deltatime)
 
 void minigame_cleanup()
 {
-    wav64_close(&sfx_start);
-    wav64_close(&sfx_countdown);
-    wav64_close(&sfx_stop);
-    wav64_close(&sfx_winner);
-    display_close();
+    for (size_t i = 0; i < MAXPLAYERS; i++)
+        core_text_free(&text_players[i]);
     rdpq_text_unregister_font(FONT_TEXT);
     rdpq_font_free(font);
-}
\ No newline at end of file
+}
+
+
+MINIGAME_INTERFACE(minigame_def, minigame_init, minigame_fixedloop, minigame_loop, minigame_cleanup);
@@ -0,0 +1,127 @@
+#include <math.h>
+#include "aiguess.h"
+#include "aiparams.h"
+
+#define NORMAL_TABLE_SIZE 256
+
+// Quantiles of the standard normal distribution at k/256 (tails clamped to +-3.1)
+static const float normal_quantiles[NORMAL_TABLE_SIZE+1] = {
+    -3.097269f, -2.660067f, -2.417559f, -2.266227f, -2.153875f, -2.063528f, -1.987428f, -1.921351f,
+    -1.862732f, -1.809892f, -1.761670f, -1.717228f, -1.675940f, -1.637325f, -1.601009f, -1.566689f,
+    -1.534121f, -1.503103f, -1.473468f, -1.445073f, -1.417797f, -1.391537f, -1.366204f, -1.341718f,
+    -1.318011f, -1.295022f, -1.272699f, -1.250992f, -1.229859f, -1.209261f, -1.189164f, -1.169537f,
+    -1.150349f, -1.131577f, -1.113194f, -1.095181f, -1.077516f, -1.060180f, -1.043158f, -1.026433f,
+    -1.009990f, -0.993816f, -0.977898f, -0.962223f, -0.946782f, -0.931563f, -0.916557f, -0.901754f,
+    -0.887147f, -0.872726f, -0.858484f, -0.844415f, -0.830511f, -0.816765f, -0.803173f, -0.789727f,
+    -0.776422f, -0.763253f, -0.750215f, -0.737304f, -0.724514f, -0.711842f, -0.699283f, -0.686834f,
+    -0.674490f, -0.662248f, -0.650104f, -0.638056f, -0.626099f, -0.614231f, -0.602449f, -0.590751f,
+    -0.579132f, -0.567591f, -0.556126f, -0.544733f, -0.533410f, -0.522155f, -0.510966f, -0.499840f,
+    -0.488776f, -0.477772f, -0.466825f, -0.455934f, -0.445097f, -0.434311f, -0.423576f, -0.412890f,
+    -0.402250f, -0.391656f, -0.381105f, -0.370597f, -0.360130f, -0.349702f, -0.339312f, -0.328958f,
+    -0.318639f, -0.308355f, -0.298102f, -0.287881f, -0.277690f, -0.267528f, -0.257394f, -0.247285f,
+    -0.237202f, -0.227143f, -0.217107f, -0.207093f, -0.197099f, -0.187125f, -0.177170f, -0.167232f,
+    -0.157311f, -0.147405f, -0.137513f, -0.127635f, -0.117770f, -0.107916f, -0.098072f, -0.088238f,
+    -0.078412f, -0.068594f, -0.058783f, -0.048977f, -0.039176f, -0.029379f, -0.019584f, -0.009792f,
+    +0.000000f, +0.009792f, +0.019584f, +0.029379f, +0.039176f, +0.048977f, +0.058783f, +0.068594f,
+    +0.078412f, +0.088238f, +0.098072f, +0.107916f, +0.117770f, +0.127635f, +0.137513f, +0.147405f,
+    +0.157311f, +0.167232f, +0.177170f, +0.187125f, +0.197099f, +0.207093f, +0.217107f, +0.227143f,
+    +0.237202f, +0.247285f, +0.257394f, +0.267528f, +0.277690f, +0.287881f, +0.298102f, +0.308355f,
+    +0.318639f, +0.328958f, +0.339312f, +0.349702f, +0.360130f, +0.370597f, +0.381105f, +0.391656f,
+    +0.402250f, +0.412890f, +0.423576f, +0.434311f, +0.445097f, +0.455934f, +0.466825f, +0.477772f,
+    +0.488776f, +0.499840f, +0.510966f, +0.522155f, +0.533410f, +0.544733f, +0.556126f, +0.567591f,
+    +0.579132f, +0.590751f, +0.602449f, +0.614231f, +0.626099f, +0.638056f, +0.650104f, +0.662248f,
+    +0.674490f, +0.686834f, +0.699283f, +0.711842f, +0.724514f, +0.737304f, +0.750215f, +0.763253f,
+    +0.776422f, +0.789727f, +0.803173f, +0.816765f, +0.830511f, +0.844415f, +0.858484f, +0.872726f,
+    +0.887147f, +0.901754f, +0.916557f, +0.931563f, +0.946782f, +0.962223f, +0.977898f, +0.993816f,
+    +1.009990f, +1.026433f, +1.043158f, +1.060180f, +1.077516f, +1.095181f, +1.113194f, +1.131577f,
+    +1.150349f, +1.169537f, +1.189164f, +1.209261f, +1.229859f, +1.250992f, +1.272699f, +1.295022f,
+    +1.318011f, +1.341718f, +1.366204f, +1.391537f, +1.417797f, +1.445073f, +1.473468f, +1.503103f,
+    +1.534121f, +1.566689f, +1.601009f, +1.637325f, +1.675940f, +1.717228f, +1.761670f, +1.809892f,
+    +1.862732f, +1.921351f, +1.987428f, +2.063528f, +2.153875f, +2.266227f, +2.417559f, +2.660067f,
+    +3.097269f,
+};
+
+void ai_rng_seed(AiRng *rng, uint32_t seed) {
+    // xorshift must never have a zero state
+    rng->state = seed ? seed : 0x9E3779B9;
+}
+
+uint32_t ai_rng_next(AiRng *rng) {
+    uint32_t x = rng->state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rng->state = x;
+    return x;
+}
+
+float ai_rng_uniform(AiRng *rng) {
+    // 24 bits of randomness in [0, 1)
+    return (ai_rng_next(rng) >> 8) * (1.0f / 16777216.0f);
+}
+
+static float normal_quantile(float u) {
+    float f = u * NORMAL_TABLE_SIZE;
+    int i = (int)f;
+    if (i < 0) return normal_quantiles[0];
+    if (i >= NORMAL_TABLE_SIZE) return normal_quantiles[NORMAL_TABLE_SIZE];
+    float frac = f - i;
+    return normal_quantiles[i] + (normal_quantiles[i+1] - normal_quantiles[i]) * frac;
+}
+
+static float normal_cdf(float z) {
+    if (z <= normal_quantiles[0]) return 0.0f;
+    if (z >= normal_quantiles[NORMAL_TABLE_SIZE]) return 1.0f;
+
+    // Fixed number of steps: binary search over the table
+    int lo = 0, hi = NORMAL_TABLE_SIZE;
+    while (hi - lo > 1) {
+        int mid = (lo + hi) / 2;
+        if (normal_quantiles[mid] <= z) lo = mid;
+        else hi = mid;
+    }
+    float frac = (z - normal_quantiles[lo]) / (normal_quantiles[hi] - normal_quantiles[lo]);
+    return (lo + frac) * (1.0f / NORMAL_TABLE_SIZE);
+}
+
+float ai_normal(AiRng *rng, float mean, float stddev) {
+    return mean + stddev * normal_quantile(ai_rng_uniform(rng));
+}
+
+float ai_normal_truncated(AiRng *rng, float min, float max, float mean, float stddev) {
+    // Sample the inverse CDF only over the allowed range, instead of rejecting
+    float umin = normal_cdf((min - mean) / stddev);
+    float umax = normal_cdf((max - mean) / stddev);
+    float x = mean + stddev * normal_quantile(umin + (umax - umin) * ai_rng_uniform(rng));
+    if (x < min) x = min;
+    if (x > max) x = max;
+    return x;
+}
+
+void ai_normal_batch(AiRng *rng, float *out, int count, float mean, float stddev) {
+    for (int i = 0; i < count; i++)
+        out[i] = mean + stddev * normal_quantile(ai_rng_uniform(rng));
+}
+
+void ai_generate_guess(AiRng *rng, AiGuess *out, int num_faces, int difficulty) {
+    ai_generate_guess_params(rng, out, num_faces, ai_stddev[difficulty], ai_times[difficulty]);
+}
+
+void ai_generate_guess_params(AiRng *rng, AiGuess *out, int num_faces, float stddev, float time) {
+    // The first guesses are rougher than the last one
+    float z[AI_NUM_GUESSES];
+    ai_normal_batch(rng, z, AI_NUM_GUESSES, 0.0f, stddev);
+    for (int j = 0; j < AI_NUM_GUESSES; j++) {
+        int guess = num_faces + z[j] * (AI_NUM_GUESSES - j);
+        if (guess < 0) guess = 0;
+        if (guess > AI_MAX_GUESS) guess = AI_MAX_GUESS;
+        out->guesses[j] = guess;
+    }
+
+    float t2 = ai_normal_truncated(rng, time/2, AI_MAX_TIME*1.3f, time, stddev*2);
+    float t1 = ai_normal_truncated(rng, t2*0.4f, t2*0.8f, t2*0.6f, stddev*2);
+    float t0 = ai_normal_truncated(rng, t1*0.4f, t1*0.8f, t1*0.6f, stddev*2);
+    out->times[2] = t2;
+    out->times[1] = t1;
+    out->times[0] = t0;
+}
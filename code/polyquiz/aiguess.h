@@ -0,0 +1,36 @@
+#ifndef POLYQUIZ_AIGUESS_H
+#define POLYQUIZ_AIGUESS_H
+
+// AI guess generation. This file doesn't depend on libdragon, so it can
+// also be built into the host-side tuning harness in tools/.
+
+#include <stdint.h>
+
+#define AI_NUM_GUESSES   3
+#define AI_MAX_GUESS     40
+#define AI_MAX_TIME      20.0f
+
+// Small seeded PRNG (xorshift32), so that rounds can be replayed
+typedef struct {
+    uint32_t state;
+} AiRng;
+
+typedef struct {
+    int guesses[AI_NUM_GUESSES];
+    float times[AI_NUM_GUESSES];
+} AiGuess;
+
+void     ai_rng_seed(AiRng *rng, uint32_t seed);
+uint32_t ai_rng_next(AiRng *rng);
+float    ai_rng_uniform(AiRng *rng);
+
+// Bounded-time normal sampling through an inverse-CDF table (no rejection loops)
+float ai_normal(AiRng *rng, float mean, float stddev);
+float ai_normal_truncated(AiRng *rng, float min, float max, float mean, float stddev);
+void  ai_normal_batch(AiRng *rng, float *out, int count, float mean, float stddev);
+
+// Generates the guesses (and the times they are made at) of one AI player
+void ai_generate_guess(AiRng *rng, AiGuess *out, int num_faces, int difficulty);
+void ai_generate_guess_params(AiRng *rng, AiGuess *out, int num_faces, float stddev, float time);
+
+#endif
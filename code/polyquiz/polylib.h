@@ -0,0 +1,52 @@
+#ifndef POLYQUIZ_POLYLIB_H
+#define POLYQUIZ_POLYLIB_H
+
+// Polyhedron types and the layout of the prebaked polyhedron library.
+// Shared between the game and the host-side tools, so it doesn't depend on libdragon.
+//
+// The library is generated at build time by tools/polybake.c into
+// filesystem/polyquiz/polyhedra.bin. All values are big endian:
+//
+//   char     magic[4]            "PQLB"
+//   uint32_t version             POLYLIB_VERSION
+//   uint32_t count               Number of polyhedra
+//   uint32_t offsets[count]      File offset of each record
+//   Records (4 byte aligned):
+//     PolyLibRecord              Vertex and face count
+//     float    vertices[num_vertices][3]
+//     PolyLibFace faces[num_faces]
+
+#include <stdint.h>
+
+#define MAX_VERTICES 100
+#define MAX_FACES 200
+#define PALETTE_SIZE 8
+
+#define POLYLIB_MAGIC    "PQLB"
+#define POLYLIB_VERSION  1
+
+typedef struct {
+    float x, y, z;
+} Vertex;
+
+typedef struct {
+    int v1, v2, v3;
+    int color_idx;
+} Face;
+
+typedef struct {
+    uint8_t num_vertices;
+    uint8_t num_faces;
+    uint8_t padding[2];
+} PolyLibRecord;
+
+typedef struct {
+    uint8_t v1, v2, v3;
+    uint8_t color_idx;
+    float normal[3];
+} PolyLibFace;
+
+_Static_assert(sizeof(PolyLibRecord) == 4, "PolyLibRecord must be packed");
+_Static_assert(sizeof(PolyLibFace) == 16, "PolyLibFace must be packed");
+
+#endif
@@ -1,38 +1,60 @@
 #include <libdragon.h>
+#include <string.h>
 #include "../../minigame.h"
 #include "../../core.h"
 #include <GL/gl.h>
 #include <GL/glu.h>
 #include <GL/gl_integration.h>
+#include "polylib.h"
+#include "aiguess.h"
 
-#define MAX_VERTICES 100
-#define MAX_FACES 200
 #define NUM_BKGS 20
 
 #define MAX_TIME  20.0f
 #define FADEIN_TIME 2.0f
 #define FADEOUT_TIME 3.0f
 
+// Render scale: SCALE_FULL renders at 640x480, SCALE_HALF renders at 320x240 and lets
+// the VI upscale, SCALE_DYNAMIC starts at full resolution and drops to half resolution
+// if the frames measured during the fade-in are over budget
+#define SCALE_FULL      0
+#define SCALE_HALF      1
+#define SCALE_DYNAMIC   2
+#define RENDER_SCALE    SCALE_DYNAMIC
+
+// When rendering at half resolution, keep the text at 640x480 by rendering the scene
+// into a 320x240 buffer and upscaling it into the full resolution framebuffer
+#define FULLRES_TEXT    0
+
+#if RENDER_SCALE == SCALE_HALF && !FULLRES_TEXT
+    #define INITIAL_RESOLUTION  RESOLUTION_320x240
+    #define INITIAL_BUFFERS     3
+#else
+    #define INITIAL_RESOLUTION  RESOLUTION_640x480
+    #define INITIAL_BUFFERS     2
+#endif
+
+#define FRAME_BUDGET    (1.0f/30.0f)
+#define DYNAMIC_SAMPLES 20
+
 const MinigameDef minigame_def = {
     .gamename = "Polyquiz",
     .developername = "Rasky",
     .description = "Simple OpenGL game. Can you guess how many faces a polyhedron has?",
     .instructions = "D-Pad to change your guess, A to confirm",
+    .display = {
+        .resolution = INITIAL_RESOLUTION,
+        .depth = DEPTH_16_BPP,
+        .buffers = INITIAL_BUFFERS,
+        .filter = FILTERS_RESAMPLE_ANTIALIAS,
+    },
+    .systems = CORE_SYSTEM_GL,
 };
 
 typedef struct {
     float r, g, b;
 } Color;
 
-typedef struct {
-    float x, y, z;
-} Vertex;
-
-typedef struct {
-    int v1, v2, v3;
-    int color_idx;
-} Face;
-
 Color palette[] = {
     {0.894f, 0.102f, 0.110f},  // Rosso brillante
     {0.216f, 0.494f, 0.722f},  // Blu brillante
@@ -43,7 +65,7 @@ Color palette[] = {
     {0.651f, 0.337f, 0.157f},  // Marrone
     {0.968f, 0.505f, 0.749f},  // Rosa
 };
-#define PALETTE_SIZE (sizeof(palette) / sizeof(palette[0]))
+_Static_assert(sizeof(palette) / sizeof(palette[0]) == PALETTE_SIZE, "Palette size mismatch");
 
 Color random_color_from_palette() {
     int index = rand() % PALETTE_SIZE;
@@ -52,13 +74,28 @@ Color random_color_from_palette() {
 
 Vertex vertices[MAX_VERTICES];
 Face faces[MAX_FACES];
+Vertex face_normals[MAX_FACES];
 int num_vertices = 0;
 int num_faces = 0;
 rspq_block_t *poly = NULL;
 sprite_t *bkg[NUM_BKGS];
 rdpq_font_t *font = NULL;
+rdpq_font_t *font_small = NULL;
 #define FONT_TEXT 1
 
+// Render scale state
+int render_scale;
+float hud_scale;            // HUD coordinates are authored for 640x480
+surface_t scene_surface;    // Only used with FULLRES_TEXT at half resolution
+float scale_frametime[2];
+int scale_frames[2];
+
+// Retained HUD text, only laid out again when the value changes
+CoreText text_status;
+CoreText text_winner;
+CoreText text_timer[5];
+CoreText text_guess[4];
+
 typedef enum {
     GS_FADEIN,
     GS_PLAY,
@@ -75,6 +112,20 @@ float rotationSpeed = 40.0f;
 float axisX = 0.0f, axisY = 1.0f, axisZ = 0.0f; 
 float zoom = 1.0f;
 
+typedef struct {
+    float x, y, z, w;
+} Quat;
+
+// Orientation at the current and previous fixed tick, interpolated when drawing
+Quat orient = {0.0f, 0.0f, 0.0f, 1.0f};
+Quat prev_orient = {0.0f, 0.0f, 0.0f, 1.0f};
+Quat spin = {0.0f, 0.0f, 0.0f, 1.0f};   // Rotation applied every fixed tick
+float prev_zoom = 1.0f;
+
+// Time spent building the modelview matrix
+uint64_t modelview_ticks = 0;
+uint32_t modelview_frames = 0;
+
 struct {
     int guess;
     bool confirmed;
@@ -83,132 +134,64 @@ struct {
     float ai_guess_times[3];
 } player[4];
 
-void generateRandomAxis() {
-    axisX = ((float)rand() / RAND_MAX) * 2.0f - 1.0f;
-    axisY = ((float)rand() / RAND_MAX) * 2.0f - 1.0f;
-    axisZ = ((float)rand() / RAND_MAX) * 2.0f - 1.0f;
-
-    float length = sqrtf(axisX * axisX + axisY * axisY + axisZ * axisZ);
-    if (length > 0.0f) {
-        axisX /= length;
-        axisY /= length;
-        axisZ /= length;
-    }
-}
-
-Vertex random_vertex(float range_min, float range_max) {
-    Vertex v;
-
-    float radius = (range_max - range_min)/2;
-    float theta = ((float)rand() / RAND_MAX) * 2.0f * 3.1415628f;
-    float phi = acosf(1.0f - 2.0f * ((float)rand() / RAND_MAX));
-
-    v.x = radius * sinf(phi) * cosf(theta);
-    v.y = radius * sinf(phi) * sinf(theta);
-    v.z = radius * cosf(phi);
+AiRng ai_rng;
 
-    return v;
+Quat quat_mul(Quat a, Quat b) {
+    return (Quat){
+        a.w*b.x + a.x*b.w + a.y*b.z - a.z*b.y,
+        a.w*b.y - a.x*b.z + a.y*b.w + a.z*b.x,
+        a.w*b.z + a.x*b.y - a.y*b.x + a.z*b.w,
+        a.w*b.w - a.x*b.x - a.y*b.y - a.z*b.z,
+    };
 }
 
-Vertex cross_product(Vertex v1, Vertex v2) {
-    Vertex result;
-    result.x = v1.y * v2.z - v1.z * v2.y;
-    result.y = v1.z * v2.x - v1.x * v2.z;
-    result.z = v1.x * v2.y - v1.y * v2.x;
-    return result;
+Quat quat_normalize(Quat q) {
+    float inv = 1.0f / sqrtf(q.x*q.x + q.y*q.y + q.z*q.z + q.w*q.w);
+    return (Quat){ q.x*inv, q.y*inv, q.z*inv, q.w*inv };
 }
 
-Vertex subtract(Vertex v1, Vertex v2) {
-    Vertex result;
-    result.x = v1.x - v2.x;
-    result.y = v1.y - v2.y;
-    result.z = v1.z - v2.z;
-    return result;
-}
-
-float dot_product(Vertex v1, Vertex v2) {
-    return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z;
+void update_spin() {
+    // The axis is only normalized here, once per axis change, folded into the quaternion
+    float len2 = axisX * axisX + axisY * axisY + axisZ * axisZ;
+    if (len2 <= 0.0f) {
+        axisX = 0.0f; axisY = 1.0f; axisZ = 0.0f;
+        len2 = 1.0f;
+    }
+    float s, c;
+    fm_sincosf(rotationSpeed * DELTATIME * (M_PI / 180.0f) * 0.5f, &s, &c);
+    s /= sqrtf(len2);
+    spin = (Quat){ axisX * s, axisY * s, axisZ * s, c };
 }
 
-int is_convex(Vertex p, Vertex q, Vertex r, Vertex s) {
-    Vertex pq = subtract(q, p);
-    Vertex pr = subtract(r, p);
-    Vertex ps = subtract(s, p);
-    Vertex n = cross_product(pq, pr);
-    return dot_product(n, ps) >= 0;
+void generateRandomAxis() {
+    axisX = ((float)rand() / RAND_MAX) * 2.0f - 1.0f;
+    axisY = ((float)rand() / RAND_MAX) * 2.0f - 1.0f;
+    axisZ = ((float)rand() / RAND_MAX) * 2.0f - 1.0f;
+    update_spin();
 }
 
-// Gift Wrapping (Jarvis March) for 3D convex hull
-void compute_convex_hull() {
-    assertf(num_vertices >= 4, "Too few points to create a polyhedron");
-
-    num_faces = 0;
-    
-    // Staring point: find the leftmost point
-    int start = 0;
-    for (int i = 1; i < num_vertices; i++) {
-        if (vertices[i].x < vertices[start].x) {
-            start = i;
-        }
-    }
-
-    int p = start;
-    do {
-        for (int i = 0; i < num_vertices; i++) {
-            for (int j = i + 1; j < num_vertices; j++) {
-                if (i != p && j != p) {
-                    int found = 1;
-                    for (int k = 0; k < num_vertices; k++) {
-                        if (k != p && k != i && k != j && !is_convex(vertices[p], vertices[i], vertices[j], vertices[k])) {
-                            found = 0;
-                            break;
-                        }
-                    }
-                    if (found) {
-                        faces[num_faces].v1 = p;
-                        faces[num_faces].v2 = i;
-                        faces[num_faces].v3 = j;
-                        num_faces++;
-                    }
-                }
-            }
-        }
-        p++;
-        if (p == num_vertices) {
-            p = 0;
-        }
-    } while (p != start && num_faces < MAX_FACES);
-}
-
-void color_polyhedron(void) {
-    int are_faces_adjacent(Face *f1, Face *f2) {
-        int shared_vertices = 0;
-        if (f1->v1 == f2->v1 || f1->v1 == f2->v2 || f1->v1 == f2->v3) shared_vertices++;
-        if (f1->v2 == f2->v1 || f1->v2 == f2->v2 || f1->v2 == f2->v3) shared_vertices++;
-        if (f1->v3 == f2->v1 || f1->v3 == f2->v2 || f1->v3 == f2->v3) shared_vertices++;
-
-        return (shared_vertices == 2);
-    }    
-    
-    int is_valid_color(Face *faces, int face_index, int color_index, int num_faces) {
-        for (int i = 0; i < num_faces; i++) {
-            if (i == face_index) continue;
-            if (are_faces_adjacent(&faces[face_index], &faces[i]) && faces[i].color_idx == color_index)
-                return false;
-        }
-        return true;
-    }
-
-
-    for (int i = 0; i < num_faces; i++) {
-        int idx = rand() % PALETTE_SIZE;
-        for (int c = 0; c < PALETTE_SIZE; c++) {
-            if (is_valid_color(faces, i, (idx+c)%PALETTE_SIZE, num_faces)) {
-                faces[i].color_idx = (idx+c) % PALETTE_SIZE;
-                break;
-            }
-        }
-    }
+// Builds the whole modelview (camera, zoom and rotation) from the interpolated
+// orientation, so it can be loaded with a single call
+void build_modelview(float *m, float t) {
+    Quat q = {
+        prev_orient.x + (orient.x - prev_orient.x) * t,
+        prev_orient.y + (orient.y - prev_orient.y) * t,
+        prev_orient.z + (orient.z - prev_orient.z) * t,
+        prev_orient.w + (orient.w - prev_orient.w) * t,
+    };
+    float z = prev_zoom + (zoom - prev_zoom) * t;
+
+    // Dividing by the norm here avoids renormalizing the lerped quaternion
+    float s = 2.0f / (q.x*q.x + q.y*q.y + q.z*q.z + q.w*q.w);
+    float xx = q.x*q.x*s, yy = q.y*q.y*s, zz = q.z*q.z*s;
+    float xy = q.x*q.y*s, xz = q.x*q.z*s, yz = q.y*q.z*s;
+    float wx = q.w*q.x*s, wy = q.w*q.y*s, wz = q.w*q.z*s;
+
+    // Column major. The camera at (0,0,4) looking at the origin is just a translation
+    m[0] = z*(1.0f - yy - zz); m[4] = z*(xy - wz);        m[8]  = z*(xz + wy);        m[12] = 0.0f;
+    m[1] = z*(xy + wz);        m[5] = z*(1.0f - xx - zz); m[9]  = z*(yz - wx);        m[13] = 0.0f;
+    m[2] = z*(xz - wy);        m[6] = z*(yz + wx);        m[10] = z*(1.0f - xx - yy); m[14] = -4.0f;
+    m[3] = 0.0f;               m[7] = 0.0f;               m[11] = 0.0f;               m[15] = 1.0f;
 }
 
 void draw_polyhedron(void)
@@ -219,11 +202,7 @@ void draw_polyhedron(void)
         Vertex v2 = vertices[faces[i].v2];
         Vertex v3 = vertices[faces[i].v3];
 
-        Vertex normal;
-        normal.x = (v2.y - v1.y) * (v3.z - v1.z) - (v2.z - v1.z) * (v3.y - v1.y);
-        normal.y = (v2.z - v1.z) * (v3.x - v1.x) - (v2.x - v1.x) * (v3.z - v1.z);
-        normal.z = (v2.x - v1.x) * (v3.y - v1.y) - (v2.y - v1.y) * (v3.x - v1.x);
-
+        Vertex normal = face_normals[i];
         glNormal3f(normal.x, normal.y, normal.z);
         Color color = palette[faces[i].color_idx];
         glColor4f(color.r, color.g, color.b, 0.8f);
@@ -235,13 +214,40 @@ void draw_polyhedron(void)
     glEnd();
 }
 
-void generate_random_polyhedron(int num_vertices_input, float range_min, float range_max) {
-    num_vertices = num_vertices_input;
-    for (int i = 0; i < num_vertices; i++) {
-        vertices[i] = random_vertex(range_min, range_max);
+// Reads one polyhedron from the library baked at build time by tools/polybake.c
+void load_polyhedron(void) {
+    FILE *f = fopen("rom:/polyquiz/polyhedra.bin", "rb");
+    assertf(f, "Unable to open the polyhedron library");
+
+    char magic[4];
+    uint32_t version, count, offset;
+    bool ok = fread(magic, 1, 4, f) == 4;
+    ok = ok && fread(&version, 4, 1, f) == 1;
+    ok = ok && fread(&count, 4, 1, f) == 1;
+    assertf(ok && !memcmp(magic, POLYLIB_MAGIC, 4) && version == POLYLIB_VERSION && count > 0, "Invalid polyhedron library");
+
+    int index = rand() % count;
+    fseek(f, 12 + index*4, SEEK_SET);
+    ok = fread(&offset, 4, 1, f) == 1;
+    ok = ok && fseek(f, offset, SEEK_SET) == 0;
+    assertf(ok, "Polyhedron %d is missing from the library", index);
+
+    PolyLibRecord rec;
+    ok = fread(&rec, sizeof(rec), 1, f) == 1;
+    assertf(ok && rec.num_vertices <= MAX_VERTICES && rec.num_faces <= MAX_FACES, "Polyhedron %d is invalid", index);
+    num_vertices = rec.num_vertices;
+    num_faces = rec.num_faces;
+    ok = (int)fread(vertices, sizeof(Vertex), num_vertices, f) == num_vertices;
+    assertf(ok, "Polyhedron %d is truncated", index);
+    for (int i = 0; i < num_faces; i++) {
+        PolyLibFace face;
+        ok = fread(&face, sizeof(face), 1, f) == 1;
+        assertf(ok, "Polyhedron %d is truncated", index);
+        assertf(face.v1 < num_vertices && face.v2 < num_vertices && face.v3 < num_vertices && face.color_idx < PALETTE_SIZE, "Polyhedron %d has an invalid face", index);
+        faces[i] = (Face){ face.v1, face.v2, face.v3, face.color_idx };
+        face_normals[i] = (Vertex){ face.normal[0], face.normal[1], face.normal[2] };
     }
-    compute_convex_hull();
-    color_polyhedron();
+    fclose(f);
 
     if (poly) rspq_block_free(poly);
     rspq_block_begin();
@@ -251,70 +257,86 @@ void generate_random_polyhedron(int num_vertices_input, float range_min, float r
     cur_bkg = rand() % NUM_BKGS;
 }
 
-float gauss_random(float mean, float stddev) {
-    static int has_spare = 0;
-    static float spare;    
-
-    if (has_spare) {
-        has_spare = 0;
-        return mean + stddev * spare;
+void generate_ai_guesses(void)
+{
+    AiDiff diff = core_get_aidifficulty();
+    for (int i=core_get_playercount(); i<4; i++) {
+        AiGuess ai;
+        ai_generate_guess(&ai_rng, &ai, num_faces, diff);
+        for (int j=0; j<3; j++) {
+            player[i].ai_guesses[j] = ai.guesses[j];
+            player[i].ai_guess_times[j] = ai.times[j];
+        }
     }
+}
 
-    has_spare = 1;
-    float u, v, s;
-    do {
-        u = (rand() / ((float) RAND_MAX)) * 2.0 - 1.0;
-        v = (rand() / ((float) RAND_MAX)) * 2.0 - 1.0;
-        s = u * u + v * v;
-    } while (s >= 1.0 || s == 0.0);
-
-    s = sqrtf(-2.0 * logf(s) / s);
-    spare = v * s;
-    return mean + stddev * u * s;
+void setup_font_styles(rdpq_font_t *f)
+{
+    rdpq_font_style(f, 0, &(rdpq_fontstyle_t){
+        .color = RGBA32(0xFF, 0xFF, 0xFF, 0xFF), .outline_color = RGBA32(0x0, 0x0, 0x0, 0xFF),
+    });
+    rdpq_font_style(f, 1, &(rdpq_fontstyle_t){
+        .color = RGBA32(palette[2].r*255, palette[2].g*255, palette[2].b*255, 0xFF),
+        .outline_color = RGBA32(0x0, 0x0, 0x0, 0xFF),
+    });
+    rdpq_font_style(f, 2, &(rdpq_fontstyle_t){
+        .color = RGBA32(palette[0].r*255, palette[0].g*255, palette[0].b*255, 0xFF),
+        .outline_color = RGBA32(0x0, 0x0, 0x0, 0xFF),
+    });
 }
 
-float random_gaussian_truncated(float A, float B, float C, float sigma) {
-    float x;
-    do {
-        float u1 = rand() / (float) RAND_MAX;
-        float u2 = rand() / (float) RAND_MAX;
-        float z0 = sqrtf(-2.0 * logf(u1)) * cosf(2.0 * 3.1415628f * u2);
-        x = C + sigma * z0;
-    } while (x < A || x > B);
-    return x;
+void free_hud_text()
+{
+    core_text_free(&text_status);
+    core_text_free(&text_winner);
+    for (int i=0; i<5; i++)
+        core_text_free(&text_timer[i]);
+    for (int i=0; i<4; i++)
+        core_text_free(&text_guess[i]);
 }
 
-void generate_ai_guesses(void)
+void set_render_scale(int scale)
 {
-    float stddev[] = { 7.0f, 4.5f, 2.0f };
-    float times[] = { 15.0f, 10.0f, 5.0f };
+    bool fullres_text = FULLRES_TEXT && scale == SCALE_HALF;
+    int framebuffers;
 
-    AiDiff diff = core_get_aidifficulty();
-    for (int i=core_get_playercount(); i<4; i++) {
-        player[i].ai_guesses[2] = gauss_random(num_faces, stddev[diff]*1.0f);
-        player[i].ai_guesses[1] = gauss_random(num_faces, stddev[diff]*2.0f);
-        player[i].ai_guesses[0] = gauss_random(num_faces, stddev[diff]*3.0f);
+    if (render_scale != -1) {
+        rdpq_text_unregister_font(FONT_TEXT);
+        free_hud_text(); // Cached layouts belong to the previous font
+    }
+    render_scale = scale;
+
+    // The core only reconfigures the display if the mode differs from the current one
+    bool fullres = (scale == SCALE_FULL || fullres_text);
+    framebuffers = fullres ? 2 : 3;
+    core_display_set(&(CoreDisplayMode){
+        .resolution = fullres ? RESOLUTION_640x480 : RESOLUTION_320x240,
+        .depth = DEPTH_16_BPP,
+        .buffers = framebuffers,
+        .filter = FILTERS_RESAMPLE_ANTIALIAS,
+    });
 
-        for (int j=0;j<3;j++) {
-            if (player[i].ai_guesses[j] < 0) player[i].ai_guesses[j] = 0;
-            if (player[i].ai_guesses[j] > 40) player[i].ai_guesses[j] = 40;
-        }
+    int scene_bytes = 0;
+    if (fullres_text) {
+        if (scene_surface.buffer == NULL)
+            scene_surface = surface_alloc(FMT_RGBA16, 320, 240);
+        scene_bytes = 320*240*2;
+        glViewport(0, 0, 320, 240);
+    } else {
+        glViewport(0, 0, display_get_width(), display_get_height());
+    }
 
-        float t2 = random_gaussian_truncated(times[diff]/2, MAX_TIME*1.3f, times[diff], stddev[diff]*2);
-        float t1 = random_gaussian_truncated(t2*0.4f, t2*0.8f, t2*0.6f, stddev[diff]*2);
-        float t0 = random_gaussian_truncated(t1*0.4f, t1*0.8f, t1*0.6f, stddev[diff]*2);
+    bool small_text = (scale == SCALE_HALF && !fullres_text);
+    hud_scale = small_text ? 0.5f : 1.0f;
+    rdpq_text_register_font(FONT_TEXT, small_text ? font_small : font);
 
-        player[i].ai_guess_times[2] = t2;
-        player[i].ai_guess_times[1] = t1;
-        player[i].ai_guess_times[0] = t0;
-    }
+    debugf("Render scale: %dx%d, %d framebuffers, %d KiB\n",
+        display_get_width(), display_get_height(), framebuffers,
+        (display_get_width()*display_get_height()*2*framebuffers + scene_bytes)/1024);
 }
 
 void minigame_init()
 {
-    display_init(RESOLUTION_640x480, DEPTH_16_BPP, 2, GAMMA_NONE, FILTERS_RESAMPLE_ANTIALIAS);
-    gl_init();
-
     glClearColor(0.1f, 0.1f, 0.1f, 1.0f);  // Colore di sfondo
 
     glEnable(GL_LIGHTING);
@@ -334,15 +356,14 @@ void minigame_init()
     glEnable(GL_COLOR_MATERIAL);
     glColorMaterial(GL_FRONT_AND_BACK, GL_AMBIENT_AND_DIFFUSE);
 
-    int w = display_get_width(), h = display_get_height();
+    // All the render scales are 4:3
     float near_plane = 1.0f;
     float far_plane = 50.0f;
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
-    gluPerspective(45.0, (GLfloat)w / (GLfloat)h, near_plane, far_plane);
+    gluPerspective(45.0, 4.0f / 3.0f, near_plane, far_plane);
 
-    int num_vertices = rand() % 10 + 5;
-    generate_random_polyhedron(num_vertices, -1.0f, 1.0f);
+    load_polyhedron();
 
     for (int i=0; i<NUM_BKGS; i++) {
         char fn[64];
@@ -350,47 +371,64 @@ void minigame_init()
         bkg[i] = sprite_load(fn);
     }
     font = rdpq_font_load("rom:/polyquiz/abaddon.font64");
-    rdpq_text_register_font(FONT_TEXT, font);
-    rdpq_font_style(font, 0, &(rdpq_fontstyle_t){
-        .color = RGBA32(0xFF, 0xFF, 0xFF, 0xFF), .outline_color = RGBA32(0x0, 0x0, 0x0, 0xFF),
-    });
-    rdpq_font_style(font, 1, &(rdpq_fontstyle_t){
-        .color = RGBA32(palette[2].r*255, palette[2].g*255, palette[2].b*255, 0xFF),
-        .outline_color = RGBA32(0x0, 0x0, 0x0, 0xFF),
-    });
-    rdpq_font_style(font, 2, &(rdpq_fontstyle_t){
-        .color = RGBA32(palette[0].r*255, palette[0].g*255, palette[0].b*255, 0xFF),
-        .outline_color = RGBA32(0x0, 0x0, 0x0, 0xFF),
-    });
+    setup_font_styles(font);
+    font_small = rdpq_font_load("rom:/polyquiz/abaddon_small.font64");
+    setup_font_styles(font_small);
+
+    render_scale = -1;
+    set_render_scale(RENDER_SCALE == SCALE_HALF ? SCALE_HALF : SCALE_FULL);
+    for (int i=0; i<2; i++) {
+        scale_frametime[i] = 0;
+        scale_frames[i] = 0;
+    }
 
+    ai_rng_seed(&ai_rng, rand());
     generate_ai_guesses();
 
     state = GS_FADEIN;
     state_time = FADEIN_TIME;
-    zoom = 0.001f;
+    zoom = prev_zoom = 0.001f;
+    angle = 0.0f;
+    orient = prev_orient = (Quat){ 0.0f, 0.0f, 0.0f, 1.0f };
+    update_spin();
+    modelview_ticks = 0;
+    modelview_frames = 0;
 }
 
 void minigame_cleanup()
 {
+    if (modelview_frames > 0)
+        debugf("Modelview setup: %lld us/frame\n", TICKS_TO_US(modelview_ticks / modelview_frames));
+    for (int i=0; i<2; i++)
+        if (scale_frames[i] > 0)
+            debugf("%s resolution: %.2f ms/frame over %d frames\n", i == SCALE_FULL ? "Full" : "Half",
+                scale_frametime[i] * 1000.0f / scale_frames[i], scale_frames[i]);
+    free_hud_text();
     rdpq_text_unregister_font(FONT_TEXT);
     rdpq_font_free(font);
+    rdpq_font_free(font_small);
+    if (scene_surface.buffer != NULL)
+        surface_free(&scene_surface);
+    scene_surface = (surface_t){0};
     for (int i=0; i<NUM_BKGS; i++) {
         sprite_free(bkg[i]);
     }
     if (poly) rspq_block_free(poly);
-    gl_close();
-    display_close();
 }
 
 void minigame_fixedloop(float dt)
 {
+    prev_orient = orient;
+    prev_zoom = zoom;
     state_time -= dt;
     switch (state) {
     case GS_PLAY:
+        orient = quat_mul(spin, orient);
         angle += rotationSpeed * dt;
         if (angle > 360.0f) {
             angle -= 360.0f;
             generateRandomAxis();
+            orient = quat_normalize(orient);
         }
         break;
     case GS_FADEIN:
@@ -450,17 +488,16 @@ void minigame_fixedloop(float dt)
 
 void minigame_loop(float dt)
 {
-    joypad_buttons_t btn = joypad_get_buttons_pressed(JOYPAD_PORT_1);
-    if (btn.start) {
+    if (core_input_get(PLAYER_1)->pressed.start) {
         debugf("Minigame ended by player (faces=%d)\n", num_faces);
         minigame_end();
     }
 
     if (state == GS_PLAY) {
-        int num_humans = core_get_playercount();
+        int num_humans = core_frame.playercount;
         for (int i=0; i<num_humans; i++) {
             if (player[i].confirmed) break;
-            joypad_buttons_t btn = joypad_get_buttons_pressed(JOYPAD_PORT_1+i);
+            joypad_buttons_t btn = core_frame.inputs[i].pressed;
             if (btn.d_up) player[i].guess++;
             if (btn.d_down) player[i].guess--;
             if (btn.d_left) player[i].guess -= 10;
@@ -471,50 +508,87 @@ void minigame_loop(float dt)
         }
     }
     
+    // Measure the frame time at each scale, and drop the resolution if it's over budget
+    scale_frametime[render_scale] += dt;
+    scale_frames[render_scale]++;
+    if (RENDER_SCALE == SCALE_DYNAMIC && render_scale == SCALE_FULL && state == GS_FADEIN &&
+        scale_frames[SCALE_FULL] == DYNAMIC_SAMPLES && scale_frametime[SCALE_FULL] > FRAME_BUDGET*DYNAMIC_SAMPLES) {
+        set_render_scale(SCALE_HALF);
+    }
+
+    // With full resolution text, the scene is drawn at 320x240 and upscaled afterwards
     surface_t *disp = display_get();
-    rdpq_attach(disp, NULL);
+    surface_t *scene = (render_scale == SCALE_HALF && FULLRES_TEXT) ? &scene_surface : disp;
+    rdpq_attach(scene, NULL);
 
     rdpq_set_mode_copy(false);
     rdpq_sprite_upload(TILE0, bkg[cur_bkg], &(rdpq_texparms_t){
         .s.repeats = REPEAT_INFINITE, .t.repeats = REPEAT_INFINITE,
     });
-    rdpq_texture_rectangle(TILE0, 0, 0, display_get_width(), display_get_height(), 0, 0);
+    rdpq_texture_rectangle(TILE0, 0, 0, scene->width, scene->height, 0, 0);
 
     gl_context_begin();
 
+    uint32_t modelview_start = TICKS_READ();
     glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
-    gluLookAt(0.0, 0.0, 4.0,  // Camera pos
-              0.0, 0.0, 0.0,  // Look at
-              0.0, 1.0, 0.0); // Up vector
-
-    glScalef(zoom, zoom, zoom);
-    glRotatef(angle, axisX, axisY, axisZ);
+    #if DEBUG
+    // Hold Z to go through the GL matrix stack instead, to compare the cost of both paths
+    if (core_input_get(PLAYER_1)->held.z) {
+        Quat q = quat_normalize(orient);
+        float sinhalf = sqrtf(1.0f - q.w*q.w);
+        glLoadIdentity();
+        gluLookAt(0.0, 0.0, 4.0,  // Camera pos
+                  0.0, 0.0, 0.0,  // Look at
+                  0.0, 1.0, 0.0); // Up vector
+        glScalef(zoom, zoom, zoom);
+        if (sinhalf > 0.0001f)
+            glRotatef(2.0f*acosf(q.w) * (180.0f / M_PI), q.x/sinhalf, q.y/sinhalf, q.z/sinhalf);
+    } else
+    #endif
+    {
+        float modelview[16];
+        build_modelview(modelview, core_get_subtick());
+        glLoadMatrixf(modelview);
+    }
+    modelview_ticks += TICKS_READ() - modelview_start;
+    modelview_frames++;
 
     rspq_block_run(poly);
 
     gl_context_end();
 
+    if (scene != disp) {
+        rdpq_detach();
+        rdpq_attach(disp, NULL);
+        rdpq_set_mode_standard();
+        rdpq_tex_blit(scene, 0, 0, &(rdpq_blitparms_t){ .scale_x = 2.0f, .scale_y = 2.0f });
+    }
+
     rdpq_set_mode_standard();
     switch (state) {
     case GS_FADEIN:
-        rdpq_text_printf(&(rdpq_textparms_t){
+        core_text_print(&text_status, &(rdpq_textparms_t){
             .width = display_get_width(), .align = ALIGN_CENTER,
-        }, FONT_TEXT, 0, 50, "Guess the number of faces!");
+        }, FONT_TEXT, 0, 50*hud_scale, "Guess the number of faces!");
         break;
     case GS_PLAY: {
-        char buf[16];
-        sprintf(buf, "%02d:%02d", (int)state_time, (int)((state_time - (int)state_time) * 100));
-        rdpq_text_printf(NULL, FONT_TEXT, 250, 50, "%c", buf[0]);
-        rdpq_text_printf(NULL, FONT_TEXT, 270, 50, "%c", buf[1]);
-        rdpq_text_printf(NULL, FONT_TEXT, 295, 50, "%c", ':');
-        rdpq_text_printf(NULL, FONT_TEXT, 310, 50, "%c", buf[3]);
-        rdpq_text_printf(NULL, FONT_TEXT, 330, 50, "%c", buf[4]);
+        // Each character is drawn at a fixed position so the digits don't wobble
+        const int timer_x[5] = { 250, 270, 295, 310, 330 };
+        float t = state_time > 0 ? state_time : 0;
+        int secs = (int)t;
+        int cents = (int)((t - secs) * 100);
+        char buf[5][2] = {
+            { '0' + (secs/10)%10, '\0' }, { '0' + secs%10, '\0' },
+            { ':', '\0' },
+            { '0' + (cents/10)%10, '\0' }, { '0' + cents%10, '\0' },
+        };
+        for (int i=0; i<5; i++)
+            core_text_print(&text_timer[i], NULL, FONT_TEXT, timer_x[i]*hud_scale, 50*hud_scale, buf[i]);
     }   break;
     case GS_RESULT:
-        rdpq_text_printf(&(rdpq_textparms_t){
+        core_text_printf(&text_status, &(rdpq_textparms_t){
             .width = display_get_width(), .align = ALIGN_CENTER,
-        }, FONT_TEXT, 0, 50, "Faces: %d", num_faces);
+        }, FONT_TEXT, 0, 50*hud_scale, "Faces: %d", num_faces);
 
         // Found the player with the closest guess, and between evens,
         // the one with the earliest guess
@@ -530,15 +604,15 @@ void minigame_loop(float dt)
         }
 
         if (closest != -1) {
-            rdpq_text_printf(&(rdpq_textparms_t){
+            core_text_printf(&text_winner, &(rdpq_textparms_t){
                 .width = display_get_width(), .align = ALIGN_CENTER,
                 .style_id = 1,
-            }, FONT_TEXT, 0, 240, "Player %d wins!", closest+1);
+            }, FONT_TEXT, 0, 240*hud_scale, "Player %d wins!", closest+1);
         } else {
-            rdpq_text_printf(&(rdpq_textparms_t){
+            core_text_print(&text_winner, &(rdpq_textparms_t){
                 .width = display_get_width(), .align = ALIGN_CENTER,
                 .style_id = 1,
-            }, FONT_TEXT, 0, 240, "Nobody wins");
+            }, FONT_TEXT, 0, 240*hud_scale, "Nobody wins");
         }
         break;
     default:
@@ -550,9 +624,11 @@ void minigame_loop(float dt)
             rdpq_textparms_t parms = {
                 .style_id = player[i].confirmed ? 1 : (state == GS_PLAY ? 0 : 2),
             };
-            rdpq_text_printf(&parms, FONT_TEXT, 100+i*140, 460, "%d", player[i].guess);
+            core_text_printf(&text_guess[i], &parms, FONT_TEXT, (100+i*140)*hud_scale, 460*hud_scale, "%d", player[i].guess);
         }
     }
 
     rdpq_detach_show();
 }
+
+MINIGAME_INTERFACE(minigame_def, minigame_init, minigame_fixedloop, minigame_loop, minigame_cleanup);
@@ -1,3 +1,6 @@
+# Most of the frame is spent in float math (quaternions, GL transforms)
+polyquiz_OPTFLAGS = -O3
+
 ASSETS_LIST += \
 	filesystem/polyquiz/abaddon.font64 \
 	filesystem/polyquiz/plaster1.ci4.sprite \
@@ -19,6 +22,42 @@ ASSETS_LIST += \
 	filesystem/polyquiz/plaster17.ci4.sprite \
 	filesystem/polyquiz/plaster18.ci4.sprite \
 	filesystem/polyquiz/plaster19.ci4.sprite \
-	filesystem/polyquiz/plaster20.ci4.sprite
+	filesystem/polyquiz/plaster20.ci4.sprite \
+	filesystem/polyquiz/polyhedra.bin \
+	filesystem/polyquiz/abaddon_small.font64
 	
 filesystem/polyquiz/abaddon.font64: MKFONT_FLAGS += --outline 3 --size 32
+
+# Smaller copy of the font for the 320x240 render scale. mkfont names the output
+# after its input, so convert into a scratch folder and rename the result.
+filesystem/polyquiz/abaddon_small.font64: MKFONT_FLAGS += --outline 2 --size 16
+filesystem/polyquiz/abaddon_small.font64: assets/polyquiz/abaddon.ttf
+	@mkdir -p $(dir $@) $(BUILD_DIR)/polyquiz/small
+	@echo "    [FONT] $@"
+	@$(ASSETCACHE) $@ "$<" -- '$(N64_MKFONT) $(MKFONT_FLAGS) --compress $(FONT_COMPRESS) -o $(BUILD_DIR)/polyquiz/small "$<" && mv $(BUILD_DIR)/polyquiz/small/abaddon.font64 $@'
+
+# Number of polyhedra baked into the library, and the seed used to generate them
+POLYQUIZ_LIBRARY_SIZE = 512
+POLYQUIZ_LIBRARY_SEED = 1
+
+# Host-side tool that bakes the polyhedron library
+$(BUILD_DIR)/polyquiz/polybake: code/polyquiz/tools/polybake.c code/polyquiz/tools/polyhedron.c
+	@mkdir -p $(dir $@)
+	@echo "    [HOST-CC] $@"
+	@$(HOST_CC) $(HOST_CFLAGS) -o $@ $^ -lm
+
+filesystem/polyquiz/polyhedra.bin: $(BUILD_DIR)/polyquiz/polybake
+	@mkdir -p $(dir $@)
+	@echo "    [POLYLIB] $@"
+	@$< -n $(POLYQUIZ_LIBRARY_SIZE) -s $(POLYQUIZ_LIBRARY_SEED) -o $@
+
+# Host-side tuning harness for the AI, regenerates aiparams.h
+$(BUILD_DIR)/polyquiz/aitune: code/polyquiz/tools/aitune.c code/polyquiz/aiguess.c code/polyquiz/tools/polyhedron.c
+	@mkdir -p $(dir $@)
+	@echo "    [HOST-CC] $@"
+	@$(HOST_CC) $(HOST_CFLAGS) -o $@ $^ -lm
+
+polyquiz-aitune: $(BUILD_DIR)/polyquiz/aitune
+	$< > code/polyquiz/aiparams.h
+
+.PHONY: polyquiz-aitune
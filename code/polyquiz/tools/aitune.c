@@ -0,0 +1,178 @@
+// Host-side Monte Carlo tuning harness for the polyquiz AI.
+//
+// Simulates millions of polyquiz rounds (one human against three AI players)
+// and searches the AI spread and answer time of each difficulty so that the
+// measured win rates and answer times match the targets below. The result is printed as a
+// replacement for aiparams.h, together with the measured win-rate table.
+//
+// Build and run with: make polyquiz-aitune
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "polyhedron.h"
+#include "../aiguess.h"
+
+#define NUM_PLAYERS       4
+#define NUM_DIFFICULTIES  3
+#define NUM_SKILLS        3
+
+#define MIN_VERTICES      5
+#define MAX_VERTICES_RND  14
+#define SHAPE_SAMPLES     2000
+
+#define SEARCH_ROUNDS     200000
+#define TABLE_ROUNDS      1000000
+#define SEARCH_STEPS      14
+
+// Simulated human players: how far off their guess usually is
+static const char *skill_names[NUM_SKILLS] = { "novice", "average", "expert" };
+static const float skill_stddev[NUM_SKILLS] = { 6.0f, 3.0f, 1.5f };
+#define REFERENCE_SKILL   1
+
+// Win rate of the average human against three AIs, and how long an AI takes to answer
+static const char *diff_names[NUM_DIFFICULTIES] = { "easy", "medium", "hard" };
+static const float target_human_winrate[NUM_DIFFICULTIES] = { 0.60f, 0.42f, 0.28f };
+static const float target_answer_time[NUM_DIFFICULTIES] = { 14.0f, 10.0f, 6.0f };
+
+// Face count distribution per number of random vertices
+static int face_hist[MAX_VERTICES_RND+1][MAX_FACES+1];
+
+typedef struct {
+    double human_wins;
+    double ai_wins;
+    double nobody_wins;
+    double ai_confirms;
+    double ai_answer_time;
+} SimResult;
+
+static void build_face_histogram(void) {
+    srand(1234);
+    for (int n = MIN_VERTICES; n <= MAX_VERTICES_RND; n++) {
+        for (int i = 0; i < SHAPE_SAMPLES; i++) {
+            generate_polyhedron_geometry(n, -1.0f, 1.0f);
+            face_hist[n][num_faces]++;
+        }
+    }
+}
+
+static int sample_faces(AiRng *rng) {
+    // Same vertex count distribution as minigame_init
+    int n = MIN_VERTICES + ai_rng_next(rng) % (MAX_VERTICES_RND - MIN_VERTICES + 1);
+    int pick = ai_rng_next(rng) % SHAPE_SAMPLES;
+    for (int f = 0; f <= MAX_FACES; f++) {
+        pick -= face_hist[n][f];
+        if (pick < 0) return f;
+    }
+    return MAX_FACES;
+}
+
+static SimResult simulate(AiRng *rng, int rounds, float stddev, float time, float human_stddev) {
+    SimResult res = {0};
+    for (int r = 0; r < rounds; r++) {
+        int faces = sample_faces(rng);
+        int guess[NUM_PLAYERS];
+        bool confirmed[NUM_PLAYERS];
+
+        // The human always confirms before the time runs out
+        int hg = faces + (int)ai_normal(rng, 0.0f, human_stddev);
+        if (hg < 0) hg = 0;
+        if (hg > AI_MAX_GUESS) hg = AI_MAX_GUESS;
+        guess[0] = hg;
+        confirmed[0] = true;
+
+        for (int i = 1; i < NUM_PLAYERS; i++) {
+            AiGuess ai;
+            ai_generate_guess_params(rng, &ai, faces, stddev, time);
+            guess[i] = ai.guesses[AI_NUM_GUESSES-1];
+            confirmed[i] = ai.times[AI_NUM_GUESSES-1] <= AI_MAX_TIME;
+            if (confirmed[i]) {
+                res.ai_confirms++;
+                res.ai_answer_time += ai.times[AI_NUM_GUESSES-1];
+            }
+        }
+
+        // Same winner rule as the GS_RESULT screen
+        int closest = -1;
+        int closest_diff = 1000;
+        for (int i = 0; i < NUM_PLAYERS; i++) {
+            if (!confirmed[i]) continue;
+            int diff = abs(guess[i] - faces);
+            if (diff < closest_diff || (diff == closest_diff && guess[i] < guess[closest])) {
+                closest = i;
+                closest_diff = diff;
+            }
+        }
+
+        if (closest == -1) res.nobody_wins++;
+        else if (closest == 0) res.human_wins++;
+        else res.ai_wins++;
+    }
+    res.human_wins /= rounds;
+    res.ai_wins /= rounds;
+    res.nobody_wins /= rounds;
+    if (res.ai_confirms > 0)
+        res.ai_answer_time /= res.ai_confirms;
+    res.ai_confirms /= (double)rounds * (NUM_PLAYERS-1);
+    return res;
+}
+
+int main(void) {
+    AiRng rng;
+    float stddev[NUM_DIFFICULTIES], time[NUM_DIFFICULTIES];
+    SimResult table[NUM_DIFFICULTIES][NUM_SKILLS];
+
+    ai_rng_seed(&rng, 0xC0FFEE);
+    fprintf(stderr, "Sampling face counts...\n");
+    build_face_histogram();
+
+    for (int d = 0; d < NUM_DIFFICULTIES; d++) {
+        stddev[d] = 4.0f;
+        time[d] = 10.0f;
+
+        // The two parameters are coupled through the answer time spread, so alternate a few times
+        for (int pass = 0; pass < 3; pass++) {
+            // A bigger spread makes the AI worse, so the human wins more often
+            float lo = 0.25f, hi = 15.0f;
+            for (int s = 0; s < SEARCH_STEPS; s++) {
+                stddev[d] = (lo + hi) / 2;
+                SimResult res = simulate(&rng, SEARCH_ROUNDS, stddev[d], time[d], skill_stddev[REFERENCE_SKILL]);
+                if (res.human_wins < target_human_winrate[d]) lo = stddev[d];
+                else hi = stddev[d];
+            }
+
+            // The answer time is truncated, so the measured mean drifts away from the parameter
+            lo = 1.0f; hi = AI_MAX_TIME;
+            for (int s = 0; s < SEARCH_STEPS; s++) {
+                time[d] = (lo + hi) / 2;
+                SimResult res = simulate(&rng, SEARCH_ROUNDS, stddev[d], time[d], skill_stddev[REFERENCE_SKILL]);
+                if (res.ai_answer_time < target_answer_time[d]) lo = time[d];
+                else hi = time[d];
+            }
+        }
+        fprintf(stderr, "%s: stddev=%.2f time=%.2f\n", diff_names[d], stddev[d], time[d]);
+
+        for (int k = 0; k < NUM_SKILLS; k++)
+            table[d][k] = simulate(&rng, TABLE_ROUNDS, stddev[d], time[d], skill_stddev[k]);
+    }
+
+    printf("#ifndef POLYQUIZ_AIPARAMS_H\n");
+    printf("#define POLYQUIZ_AIPARAMS_H\n\n");
+    printf("// Generated by tools/aitune.c (make polyquiz-aitune), do not edit by hand.\n");
+    printf("//\n");
+    printf("// Measured over %d rounds per cell, one human against three AIs:\n", TABLE_ROUNDS);
+    printf("//\n");
+    printf("//   difficulty  human skill  human wins  AI wins  nobody  AI answers in time  AI answer time\n");
+    for (int d = 0; d < NUM_DIFFICULTIES; d++)
+        for (int k = 0; k < NUM_SKILLS; k++)
+            printf("//   %-10s  %-11s  %9.1f%%  %6.1f%%  %5.1f%%  %17.1f%%  %13.1fs\n",
+                diff_names[d], skill_names[k],
+                table[d][k].human_wins*100, table[d][k].ai_wins*100,
+                table[d][k].nobody_wins*100, table[d][k].ai_confirms*100,
+                table[d][k].ai_answer_time);
+    printf("\n// AI guess spread and answer time per difficulty\n");
+    printf("static const float ai_stddev[3] = { %.2ff, %.2ff, %.2ff };\n", stddev[0], stddev[1], stddev[2]);
+    printf("static const float ai_times[3]  = { %.2ff, %.2ff, %.2ff };\n", time[0], time[1], time[2]);
+    printf("\n#endif\n");
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Host-side tool that bakes the polyquiz polyhedron library.
+//
+// Generates random convex polyhedra with the same vertex count distribution
+// as the game used to do at runtime, keeps only the ones that pass validation,
+// and writes their vertices, faces, coloring and face normals into a ROM asset
+// (see polylib.h for the layout). The game then just picks one by index.
+//
+// Usage: polybake -n <count> -s <seed> -o <output>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "polyhedron.h"
+
+#define MIN_VERTICES      5
+#define MAX_VERTICES_RND  14
+#define MAX_ATTEMPTS      1000
+
+static void write_u32(FILE *f, uint32_t v) {
+    uint8_t b[4] = { v >> 24, v >> 16, v >> 8, v };
+    fwrite(b, 1, 4, f);
+}
+
+static void write_float(FILE *f, float v) {
+    uint32_t u;
+    memcpy(&u, &v, 4);
+    write_u32(f, u);
+}
+
+int main(int argc, char *argv[]) {
+    int count = 512;
+    unsigned seed = 1;
+    const char *outfn = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i+1 < argc) count = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && i+1 < argc) seed = strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-o") && i+1 < argc) outfn = argv[++i];
+        else {
+            fprintf(stderr, "Usage: %s -n <count> -s <seed> -o <output>\n", argv[0]);
+            return 1;
+        }
+    }
+    if (!outfn || count <= 0) {
+        fprintf(stderr, "Usage: %s -n <count> -s <seed> -o <output>\n", argv[0]);
+        return 1;
+    }
+
+    FILE *f = fopen(outfn, "wb");
+    if (!f) {
+        fprintf(stderr, "Unable to open %s\n", outfn);
+        return 1;
+    }
+
+    srand(seed);
+
+    // Header and a placeholder offset table, filled in at the end
+    uint32_t *offsets = calloc(count, sizeof(uint32_t));
+    fwrite(POLYLIB_MAGIC, 1, 4, f);
+    write_u32(f, POLYLIB_VERSION);
+    write_u32(f, count);
+    for (int i = 0; i < count; i++)
+        write_u32(f, 0);
+
+    int rejected = 0;
+    for (int i = 0; i < count; i++) {
+        int attempts = 0;
+        int n = rand() % (MAX_VERTICES_RND - MIN_VERTICES + 1) + MIN_VERTICES;
+        do {
+            if (++attempts > MAX_ATTEMPTS) {
+                fprintf(stderr, "Unable to generate a valid polyhedron with %d vertices\n", n);
+                return 1;
+            }
+            generate_polyhedron_geometry(n, -1.0f, 1.0f);
+        } while (!validate_polyhedron() && ++rejected);
+
+        offsets[i] = ftell(f);
+        fputc(num_vertices, f);
+        fputc(num_faces, f);
+        fputc(0, f);
+        fputc(0, f);
+        for (int v = 0; v < num_vertices; v++) {
+            write_float(f, vertices[v].x);
+            write_float(f, vertices[v].y);
+            write_float(f, vertices[v].z);
+        }
+        for (int j = 0; j < num_faces; j++) {
+            fputc(faces[j].v1, f);
+            fputc(faces[j].v2, f);
+            fputc(faces[j].v3, f);
+            fputc(faces[j].color_idx, f);
+            write_float(f, face_normals[j].x);
+            write_float(f, face_normals[j].y);
+            write_float(f, face_normals[j].z);
+        }
+    }
+
+    fseek(f, 12, SEEK_SET);
+    for (int i = 0; i < count; i++)
+        write_u32(f, offsets[i]);
+    fseek(f, 0, SEEK_END);
+    printf("Baked %d polyhedra (%d rejected), %ld bytes\n", count, rejected, ftell(f));
+
+    free(offsets);
+    fclose(f);
+    return 0;
+}
@@ -0,0 +1,186 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <math.h>
+#include "polyhedron.h"
+
+Vertex vertices[MAX_VERTICES];
+Face faces[MAX_FACES];
+Vertex face_normals[MAX_FACES];
+int num_vertices = 0;
+int num_faces = 0;
+
+Vertex random_vertex(float range_min, float range_max) {
+    Vertex v;
+
+    float radius = (range_max - range_min)/2;
+    float theta = ((float)rand() / RAND_MAX) * 2.0f * 3.1415628f;
+    float phi = acosf(1.0f - 2.0f * ((float)rand() / RAND_MAX));
+
+    v.x = radius * sinf(phi) * cosf(theta);
+    v.y = radius * sinf(phi) * sinf(theta);
+    v.z = radius * cosf(phi);
+
+    return v;
+}
+
+Vertex cross_product(Vertex v1, Vertex v2) {
+    Vertex result;
+    result.x = v1.y * v2.z - v1.z * v2.y;
+    result.y = v1.z * v2.x - v1.x * v2.z;
+    result.z = v1.x * v2.y - v1.y * v2.x;
+    return result;
+}
+
+Vertex subtract(Vertex v1, Vertex v2) {
+    Vertex result;
+    result.x = v1.x - v2.x;
+    result.y = v1.y - v2.y;
+    result.z = v1.z - v2.z;
+    return result;
+}
+
+float dot_product(Vertex v1, Vertex v2) {
+    return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z;
+}
+
+int is_convex(Vertex p, Vertex q, Vertex r, Vertex s) {
+    Vertex pq = subtract(q, p);
+    Vertex pr = subtract(r, p);
+    Vertex ps = subtract(s, p);
+    Vertex n = cross_product(pq, pr);
+    return dot_product(n, ps) >= 0;
+}
+
+int has_face(int a, int b, int c) {
+    for (int i = 0; i < num_faces; i++) {
+        int v[3] = { faces[i].v1, faces[i].v2, faces[i].v3 };
+        int matches = 0;
+        for (int j = 0; j < 3; j++)
+            if (v[j] == a || v[j] == b || v[j] == c) matches++;
+        if (matches == 3) return 1;
+    }
+    return 0;
+}
+
+// Gift Wrapping (Jarvis March) for 3D convex hull
+void compute_convex_hull() {
+    assert(num_vertices >= 4 && "Too few points to create a polyhedron");
+
+    num_faces = 0;
+    
+    // Staring point: find the leftmost point
+    int start = 0;
+    for (int i = 1; i < num_vertices; i++) {
+        if (vertices[i].x < vertices[start].x) {
+            start = i;
+        }
+    }
+
+    int p = start;
+    do {
+        for (int i = 0; i < num_vertices; i++) {
+            for (int j = i + 1; j < num_vertices; j++) {
+                if (i != p && j != p) {
+                    int found = 1;
+                    for (int k = 0; k < num_vertices; k++) {
+                        if (k != p && k != i && k != j && !is_convex(vertices[p], vertices[i], vertices[j], vertices[k])) {
+                            found = 0;
+                            break;
+                        }
+                    }
+                    // The same face is also found when wrapping around its other vertices
+                    if (found && !has_face(p, i, j)) {
+                        faces[num_faces].v1 = p;
+                        faces[num_faces].v2 = i;
+                        faces[num_faces].v3 = j;
+                        num_faces++;
+                    }
+                }
+            }
+        }
+        p++;
+        if (p == num_vertices) {
+            p = 0;
+        }
+    } while (p != start && num_faces < MAX_FACES);
+}
+
+void color_polyhedron(void) {
+    int are_faces_adjacent(Face *f1, Face *f2) {
+        int shared_vertices = 0;
+        if (f1->v1 == f2->v1 || f1->v1 == f2->v2 || f1->v1 == f2->v3) shared_vertices++;
+        if (f1->v2 == f2->v1 || f1->v2 == f2->v2 || f1->v2 == f2->v3) shared_vertices++;
+        if (f1->v3 == f2->v1 || f1->v3 == f2->v2 || f1->v3 == f2->v3) shared_vertices++;
+
+        return (shared_vertices == 2);
+    }    
+    
+    int is_valid_color(Face *faces, int face_index, int color_index, int num_faces) {
+        for (int i = 0; i < num_faces; i++) {
+            if (i == face_index) continue;
+            if (are_faces_adjacent(&faces[face_index], &faces[i]) && faces[i].color_idx == color_index)
+                return false;
+        }
+        return true;
+    }
+
+
+    for (int i = 0; i < num_faces; i++) {
+        int idx = rand() % PALETTE_SIZE;
+        for (int c = 0; c < PALETTE_SIZE; c++) {
+            if (is_valid_color(faces, i, (idx+c)%PALETTE_SIZE, num_faces)) {
+                faces[i].color_idx = (idx+c) % PALETTE_SIZE;
+                break;
+            }
+        }
+    }
+}
+
+void generate_polyhedron_geometry(int num_vertices_input, float range_min, float range_max) {
+    num_vertices = num_vertices_input;
+    for (int i = 0; i < num_vertices; i++) {
+        vertices[i] = random_vertex(range_min, range_max);
+    }
+    compute_convex_hull();
+    color_polyhedron();
+
+    for (int i = 0; i < num_faces; i++) {
+        Vertex n = cross_product(subtract(vertices[faces[i].v2], vertices[faces[i].v1]),
+                                 subtract(vertices[faces[i].v3], vertices[faces[i].v1]));
+        float len = sqrtf(dot_product(n, n));
+        if (len > 0.0f) {
+            n.x /= len;
+            n.y /= len;
+            n.z /= len;
+        }
+        face_normals[i] = n;
+    }
+}
+
+// Checks that the hull is a closed triangulated surface (V - E + F = 2, every
+// edge shared by exactly two faces) and that the coloring is valid
+int validate_polyhedron(void) {
+    if (num_faces != 2 * num_vertices - 4) return 0;
+
+    for (int i = 0; i < num_faces; i++) {
+        int a[3] = { faces[i].v1, faces[i].v2, faces[i].v3 };
+        if (faces[i].color_idx < 0 || faces[i].color_idx >= PALETTE_SIZE) return 0;
+        for (int e = 0; e < 3; e++) {
+            int e0 = a[e], e1 = a[(e+1)%3];
+            int shared = 0;
+            for (int j = 0; j < num_faces; j++) {
+                if (j == i) continue;
+                int b[3] = { faces[j].v1, faces[j].v2, faces[j].v3 };
+                int has0 = b[0] == e0 || b[1] == e0 || b[2] == e0;
+                int has1 = b[0] == e1 || b[1] == e1 || b[2] == e1;
+                if (has0 && has1) {
+                    shared++;
+                    if (faces[j].color_idx == faces[i].color_idx) return 0;
+                }
+            }
+            if (shared != 1) return 0;
+        }
+    }
+    return 1;
+}
@@ -0,0 +1,21 @@
+#ifndef POLYQUIZ_POLYHEDRON_H
+#define POLYQUIZ_POLYHEDRON_H
+
+// Random convex polyhedron generation, used by the host-side tools to
+// bake the polyhedron library and to tune the AI.
+
+#include "../polylib.h"
+
+extern Vertex vertices[MAX_VERTICES];
+extern Face faces[MAX_FACES];
+extern Vertex face_normals[MAX_FACES];
+extern int num_vertices;
+extern int num_faces;
+
+Vertex random_vertex(float range_min, float range_max);
+void compute_convex_hull(void);
+void color_polyhedron(void);
+void generate_polyhedron_geometry(int num_vertices_input, float range_min, float range_max);
+int  validate_polyhedron(void);
+
+#endif
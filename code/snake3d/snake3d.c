@@ -13,7 +13,14 @@ const MinigameDef minigame_def = {
     .developername = "HailToDodongo",
     .description = "This is a porting of one of the Tiny3D examples, to show how to "
                    "integrate Tiny3D in minigame",
-    .instructions = "Press A to attack. Last snake slithering wins!"
+    .instructions = "Press A to attack. Last snake slithering wins!",
+    .display = {
+        .resolution = RESOLUTION_320x240,
+        .depth = DEPTH_16_BPP,
+        .buffers = 3,
+        .filter = FILTERS_RESAMPLE_ANTIALIAS,
+    },
+    .systems = CORE_SYSTEM_T3D,
 };
 
 #define FONT_TEXT           1
@@ -29,11 +36,6 @@ const MinigameDef minigame_def = {
 #define ATTACK_TIME_START   0.333f
 #define ATTACK_TIME_END     0.4f
 
-#define COUNTDOWN_DELAY     3.0f
-#define GO_DELAY            1.0f
-#define WIN_DELAY           5.0f
-#define WIN_SHOW_DELAY      2.0f
-
 #define BILLBOARD_YOFFSET   15.0f
 
 /**
@@ -75,20 +77,11 @@ typedef struct
   float attackTimer;
   PlyNum ai_target;
   int ai_reactionspeed;
+  CoreText billboard;
 } player_data;
 
 player_data players[MAXPLAYERS];
 
-float countDownTimer;
-bool isEnding;
-float endTimer;
-PlyNum winner;
-
-wav64_t sfx_start;
-wav64_t sfx_countdown;
-wav64_t sfx_stop;
-wav64_t sfx_winner;
-
 rspq_syncpoint_t syncPoint;
 
 void player_init(player_data *player, color_t color, T3DVec3 position, float rotation)
@@ -135,7 +128,7 @@ void player_init(player_data *player, color_t color, T3DVec3 position, float rot
   player->isAttack = false;
   player->isAlive = true;
   player->ai_target = rand()%MAXPLAYERS;
-  player->ai_reactionspeed = (2-core_get_aidifficulty())*5 + rand()%((3-core_get_aidifficulty())*3);
+  player->ai_reactionspeed = (2-core_frame.aidifficulty)*5 + rand()%((3-core_frame.aidifficulty)*3);
 }
 
 void minigame_init(void)
@@ -147,16 +140,13 @@ void minigame_init(void)
     color_from_packed32(PLAYERCOLOR_4<<8),
   };
 
-  display_init(RESOLUTION_320x240, DEPTH_16_BPP, 3, GAMMA_NONE, FILTERS_RESAMPLE_ANTIALIAS);
   depthBuffer = display_get_zbuf();
 
-  t3d_init((T3DInitParams){});
-
   font = rdpq_font_load("rom:/snake3d/m6x11plus.font64");
   rdpq_text_register_font(FONT_TEXT, font);
   rdpq_font_style(font, 0, &(rdpq_fontstyle_t){.color = color_from_packed32(TEXT_COLOR) });
 
-  fontBillboard = rdpq_font_load("rom:/squarewave.font64");
+  fontBillboard = core_asset_font("rom:/squarewave.font64");
   rdpq_text_register_font(FONT_BILLBOARD, fontBillboard);
   for (size_t i = 0; i < MAXPLAYERS; i++)
   {
@@ -207,15 +197,11 @@ void minigame_init(void)
     players[i].plynum = i;
   }
 
-  countDownTimer = COUNTDOWN_DELAY;
+  core_round_start(NULL);
 
   syncPoint = 0;
-  wav64_open(&sfx_start, "rom:/core/Start.wav64");
-  wav64_open(&sfx_countdown, "rom:/core/Countdown.wav64");
-  wav64_open(&sfx_stop, "rom:/core/Stop.wav64");
-  wav64_open(&sfx_winner, "rom:/core/Winner.wav64");
   xm64player_open(&music, "rom:/snake3d/bottled_bubbles.xm64");
-  xm64player_play(&music, 0);
+  xm64player_play(&music, core_audio_reserve(xm64player_num_channels(&music)));
 }
 
 void player_do_damage(player_data *player)
@@ -252,20 +238,18 @@ void player_do_damage(player_data *player)
 
 bool player_has_control(player_data *player)
 {
-  return player->isAlive && countDownTimer < 0.0f;
+  return player->isAlive && core_round_get_phase() != ROUND_COUNTDOWN;
 }
 
-void player_fixedloop(player_data *player, float deltaTime, joypad_port_t port, bool is_human)
+void player_fixedloop(player_data *player, float deltaTime, const CoreInput *input, bool is_human)
 {
   float speed = 0.0f;
   T3DVec3 newDir = {0};
 
   if (player_has_control(player)) {
     if (is_human) {
-      joypad_inputs_t joypad = joypad_get_inputs(port);
-
-      newDir.v[0] = (float)joypad.stick_x * 0.05f;
-      newDir.v[2] = -(float)joypad.stick_y * 0.05f;
+      newDir.v[0] = (float)input->stick_x * 0.05f;
+      newDir.v[2] = -(float)input->stick_y * 0.05f;
       speed = sqrtf(t3d_vec3_len2(&newDir));
     } else {
       player_data* target = &players[player->ai_target];
@@ -287,7 +271,7 @@ void player_fixedloop(player_data *player, float deltaTime, joypad_port_t port,
             t3d_anim_set_time(&player->animAttack, 0.0f);
             player->isAttack = true;
             player->attackTimer = 0;
-            player->ai_reactionspeed = (2-core_get_aidifficulty())*5 + rand()%((3-core_get_aidifficulty())*3);
+            player->ai_reactionspeed = (2-core_frame.aidifficulty)*5 + rand()%((3-core_frame.aidifficulty)*3);
           } else {
             player->ai_reactionspeed--;
           }
@@ -333,11 +317,11 @@ void player_fixedloop(player_data *player, float deltaTime, joypad_port_t port,
   }
 }
 
-void player_loop(player_data *player, float deltaTime, joypad_port_t port, bool is_human)
+void player_loop(player_data *player, float deltaTime, const CoreInput *input, bool is_human)
 {
   if (is_human && player_has_control(player))
   {
-    joypad_buttons_t btn = joypad_get_buttons_pressed(port);
+    joypad_buttons_t btn = input->pressed;
 
     if (btn.start) minigame_end();
 
@@ -402,29 +386,18 @@ void player_draw_billboard(player_data *player, PlyNum playerNum)
   rdpq_sync_pipe(); // Hardware crashes otherwise
   rdpq_sync_tile(); // Hardware crashes otherwise
 
-  rdpq_text_printf(&(rdpq_textparms_t){ .style_id = playerNum }, FONT_BILLBOARD, x-5, y-16, "P%d", playerNum+1);
+  core_text_printf(&player->billboard, &(rdpq_textparms_t){ .style_id = playerNum }, FONT_BILLBOARD, x-5, y-16, "P%d", playerNum+1);
 }
 
 void minigame_fixedloop(float deltaTime)
 {
-  bool controlbefore = player_has_control(&players[0]);
-  uint32_t playercount = core_get_playercount();
+  uint32_t playercount = core_frame.playercount;
   for (size_t i = 0; i < MAXPLAYERS; i++)
   {
-    player_fixedloop(&players[i], deltaTime, core_get_playercontroller(i), i < playercount);
+    player_fixedloop(&players[i], deltaTime, &core_frame.inputs[i], i < playercount);
   }
 
-  if (countDownTimer > -GO_DELAY)
-  {
-    float prevCountDown = countDownTimer;
-    countDownTimer -= deltaTime;
-    if ((int)prevCountDown != (int)countDownTimer && countDownTimer >= 0)
-      wav64_play(&sfx_countdown, 31);
-  }
-  if (!controlbefore && player_has_control(&players[0]))
-    wav64_play(&sfx_start, 31);
-
-  if (!isEnding) {
+  if (core_round_get_phase() < ROUND_ENDING) {
     // Determine if a player has won
     uint32_t alivePlayers = 0;
     PlyNum lastPlayer = 0;
@@ -438,18 +411,8 @@ void minigame_fixedloop(float deltaTime)
     }
     
     if (alivePlayers == 1) {
-      isEnding = true;
-      winner = lastPlayer;
-      wav64_play(&sfx_stop, 31);
-    }
-  } else {
-    float prevEndTime = endTimer;
-    endTimer += deltaTime;
-    if ((int)prevEndTime != (int)endTimer && (int)endTimer == WIN_SHOW_DELAY)
-        wav64_play(&sfx_winner, 31);
-    if (endTimer > WIN_DELAY) {
-      core_set_winner(winner);
-      minigame_end();
+      core_set_winner(lastPlayer);
+      core_round_finish();
     }
   }
 }
@@ -462,10 +425,10 @@ void minigame_loop(float deltaTime)
   t3d_viewport_set_projection(&viewport, T3D_DEG_TO_RAD(90.0f), 20.0f, 160.0f);
   t3d_viewport_look_at(&viewport, &camPos, &camTarget, &(T3DVec3){{0,1,0}});
 
-  uint32_t playercount = core_get_playercount();
+  uint32_t playercount = core_frame.playercount;
   for (size_t i = 0; i < MAXPLAYERS; i++)
   {
-    player_loop(&players[i], deltaTime, core_get_playercontroller(i), i < playercount);
+    player_loop(&players[i], deltaTime, &core_frame.inputs[i], i < playercount);
   }
 
   // ======== Draw (3D) ======== //
@@ -496,15 +459,7 @@ void minigame_loop(float deltaTime)
   rdpq_sync_tile();
   rdpq_sync_pipe(); // Hardware crashes otherwise
 
-  if (countDownTimer > 0.0f) {
-    rdpq_text_printf(NULL, FONT_TEXT, 155, 100, "%d", (int)ceilf(countDownTimer));
-  } else if (countDownTimer > -GO_DELAY) {
-    rdpq_textparms_t textparms = { .align = ALIGN_CENTER, .width = 320, };
-    rdpq_text_print(&textparms, FONT_TEXT, 0, 100, "GO!");
-  } else if (isEnding && endTimer >= WIN_SHOW_DELAY) {
-    rdpq_textparms_t textparms = { .align = ALIGN_CENTER, .width = 320, };
-    rdpq_text_printf(&textparms, FONT_TEXT, 0, 100, "Player %d wins!", winner+1);
-  }
+  core_round_draw_hud(FONT_TEXT);
 
   rdpq_detach_show();
 }
@@ -512,6 +467,7 @@ void minigame_loop(float deltaTime)
 void player_cleanup(player_data *player)
 {
   rspq_block_free(player->dplSnake);
+  core_text_free(&player->billboard);
 
   t3d_skeleton_destroy(&player->skel);
   t3d_skeleton_destroy(&player->skelBlend);
@@ -530,10 +486,6 @@ void minigame_cleanup(void)
     player_cleanup(&players[i]);
   }
 
-  wav64_close(&sfx_start);
-  wav64_close(&sfx_countdown);
-  wav64_close(&sfx_stop);
-  wav64_close(&sfx_winner);
   xm64player_stop(&music);
   xm64player_close(&music);
   rspq_block_free(dplMap);
@@ -545,10 +497,9 @@ void minigame_cleanup(void)
   free_uncached(mapMatFP);
 
   rdpq_text_unregister_font(FONT_BILLBOARD);
-  rdpq_font_free(fontBillboard);
+  core_asset_release(fontBillboard);
   rdpq_text_unregister_font(FONT_TEXT);
   rdpq_font_free(font);
-  t3d_destroy();
-
-  display_close();
 }
+
+MINIGAME_INTERFACE(minigame_def, minigame_init, minigame_fixedloop, minigame_loop, minigame_cleanup);
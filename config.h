@@ -25,4 +25,16 @@
     // The current minigame you want to test
     #define MINIGAME_TO_TEST  "examplegame"
 
+    // Initialize the audio after the first menu frame is shown instead of before it
+    #define BOOT_DEFER_AUDIO  1
+
+    // Load every asset at boot and print the measured ROM and decompression speeds.
+    // Pass them to "make size-report" to pick the right compression levels
+    #define ASSET_BENCHMARK  0
+
+    // Count the RDP commands, mode changes, syncs and texture uploads of every frame,
+    // show them on top of the round HUD and print the per-minigame totals to the debug log.
+    // This runs the rdpq debugger, so it makes the RSP and CPU a lot slower
+    #define RDP_STATS  0
+
 #endif
\ No newline at end of file
@@ -10,30 +10,18 @@ player, AI, and game loop information.
 #include "config.h"
 
 
-/*********************************
-            Structures
-*********************************/
-
-typedef struct {
-    PlyNum number;
-    joypad_port_t port;
-} Player;
-
-
 /*********************************
              Globals
 *********************************/
 
-// Player info
-static Player   global_core_players[JOYPAD_PORT_COUNT];
-static uint32_t global_core_playercount;
-static AiDiff   global_core_aidifficulty = AI_DIFFICULTY;
-
-// Minigame info
-static bool global_core_playeriswinner[MAXPLAYERS];
+// Player, minigame and core info, all in one place so that minigames can read it directly
+CoreFrameState global_core_framestate = {
+    .aidifficulty = AI_DIFFICULTY,
+    .tickrate = TICKRATE,
+};
 
-// Core info
-static double global_core_subtick = 0;
+// The read only view minigames get
+const CoreFrameState* const global_core_frame = &global_core_framestate;
 
 
 /*==============================
@@ -45,7 +33,7 @@ static double global_core_subtick = 0;
 
 void core_set_subtick(double subtick)
 {
-    global_core_subtick = subtick;
+    global_core_framestate.subtick = subtick;
 }
 
 
@@ -67,17 +55,46 @@ void core_set_playercount(uint32_t playercount)
         {
             if (joypad_is_connected(j))
             {
-                global_core_players[i].port = j;
+                global_core_framestate.ports[i] = j;
                 found = true;
                 lastcont = ++j;
                 break;
             }
         }
-        assertf(found, "Unable to find an available controller for player %d\n", i+1);
+
+        // If there aren't enough, give the player the first port nobody has.
+        // The game stays paused until a controller is plugged into it
+        if (!found)
+        {
+            debugf("Unable to find an available controller for player %d\n", i+1);
+            for (int j=0; j<JOYPAD_PORT_COUNT && !found; j++)
+            {
+                found = true;
+                for (int k=0; k<i; k++)
+                    if (global_core_framestate.ports[k] == j)
+                        found = false;
+                if (found)
+                    global_core_framestate.ports[i] = j;
+            }
+        }
     }
-    global_core_playercount = playercount;
+    global_core_framestate.playercount = playercount;
+    core_input_reset();
 }
 
+/*==============================
+    core_set_playercontroller
+    Changes the controller port of a player
+    @param  The player
+    @param  The new controller port
+==============================*/
+
+void core_set_playercontroller(PlyNum ply, joypad_port_t port)
+{
+    global_core_framestate.ports[ply] = port;
+}
+
+
 /*==============================
     core_set_aidifficulty
     Sets the AI difficulty
@@ -86,7 +103,7 @@ void core_set_playercount(uint32_t playercount)
 
 void core_set_aidifficulty(AiDiff difficulty)
 {
-    global_core_aidifficulty = difficulty;
+    global_core_framestate.aidifficulty = difficulty;
 }
 
 
@@ -99,7 +116,7 @@ void core_set_aidifficulty(AiDiff difficulty)
 
 void core_set_winner(PlyNum ply)
 {
-    global_core_playeriswinner[ply] = true;
+    global_core_framestate.winners[ply] = true;
 }
 
 
@@ -111,7 +128,7 @@ void core_set_winner(PlyNum ply)
 
 AiDiff core_get_aidifficulty()
 {
-    return global_core_aidifficulty;
+    return global_core_framestate.aidifficulty;
 }
 
 
@@ -123,7 +140,32 @@ AiDiff core_get_aidifficulty()
 
 double core_get_subtick()
 {
-    return global_core_subtick;
+    return global_core_framestate.subtick;
+}
+
+
+/*==============================
+    core_set_tickrate
+    Sets how many ticks per second the fixed loop runs at
+    @param  The number of ticks per second, or 0 for the
+            default
+==============================*/
+
+void core_set_tickrate(uint32_t tickrate)
+{
+    global_core_framestate.tickrate = (tickrate == 0) ? TICKRATE : tickrate;
+}
+
+
+/*==============================
+    core_get_tickrate
+    Gets how many ticks per second the fixed loop runs at
+    @return The number of ticks per second
+==============================*/
+
+uint32_t core_get_tickrate()
+{
+    return global_core_framestate.tickrate;
 }
 
 
@@ -135,7 +177,7 @@ double core_get_subtick()
 
 uint32_t core_get_playercount()
 {
-    return global_core_playercount;
+    return global_core_framestate.playercount;
 }
 
 
@@ -150,7 +192,7 @@ uint32_t core_get_playercount()
 
 joypad_port_t core_get_playercontroller(PlyNum ply)
 {
-    return global_core_players[ply].port;
+    return global_core_framestate.ports[ply];
 }
 
 
@@ -162,5 +204,29 @@ joypad_port_t core_get_playercontroller(PlyNum ply)
 void core_reset_winners()
 {
     for (int i=0; i<MAXPLAYERS; i++)
-        global_core_playeriswinner[i] = false;
-}
\ No newline at end of file
+        global_core_framestate.winners[i] = false;
+}
+
+
+/*==============================
+    core_get_winner
+    Checks whether a player won the minigame
+    @param  The player to check
+    @return Whether the player is a winner
+==============================*/
+
+bool core_get_winner(PlyNum ply)
+{
+    return global_core_framestate.winners[ply];
+}
+
+
+/*==============================
+    core_next_tick
+    Advances the tick counter
+==============================*/
+
+void core_next_tick()
+{
+    global_core_framestate.tick++;
+}
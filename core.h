@@ -19,6 +19,9 @@
         PLAYER_4 = 3,
     } PlyNum;
 
+    // The number of players
+    #define MAXPLAYERS  4
+
     // AI difficulty definition
     typedef enum {
         DIFF_EASY = 0,
@@ -63,6 +66,15 @@
     ==============================*/
     double core_get_subtick();
 
+    /*==============================
+        core_get_tickrate
+        Gets how many times per second minigame_fixedloop
+        is called. This is .tickrate from your MinigameDef,
+        or TICKRATE if you left it out
+        @return The number of ticks per second
+    ==============================*/
+    uint32_t core_get_tickrate();
+
     /*==============================
         core_set_winner
         Set the winner of the minigame. You can call this
@@ -71,20 +83,115 @@
     ==============================*/
     void core_set_winner(PlyNum ply);
 
+
+    /***************************************************************
+                          Core Subsystems
+    ***************************************************************/
+
+    #include "core_text.h"
+    #include "core_display.h"
+    #include "core_atlas.h"
+    #include "core_assets.h"
+    #include "core_audio.h"
+    #include "core_round.h"
+    #include "core_tween.h"
+    #include "core_input.h"
+    #include "core_boot.h"
+    #include "core_systems.h"
+    #include "core_trace.h"
+    #include "core_rdpstats.h"
+
+
+    /***************************************************************
+                           Core Frame State
+    ***************************************************************/
+
+    // A snapshot of everything the core knows about the current frame.
+    // Reading it is just a memory load, while the core_get_* functions
+    // are calls across the minigame's DSO boundary, so prefer this in 
+    // loops that run per player or per object. It fits in a few data 
+    // cache lines, and minigames can only reach it through a const 
+    // pointer, so it can't be written by accident.
+    typedef struct {
+        uint32_t      playercount;           // Same as core_get_playercount()
+        AiDiff        aidifficulty;          // Same as core_get_aidifficulty()
+        double        subtick;               // Same as core_get_subtick()
+        uint32_t      tickrate;              // Same as core_get_tickrate()
+        uint32_t      tick;                  // Fixed ticks since boot
+        joypad_port_t ports[MAXPLAYERS];     // Same as core_get_playercontroller()
+        bool          winners[MAXPLAYERS];   // Players set with core_set_winner()
+        CoreInput     inputs[MAXPLAYERS];    // Same as core_input_get()
+    } __attribute__((aligned(16))) CoreFrameState;
+
+    extern const CoreFrameState* const global_core_frame;
+
+    // Use this to read the frame state, e.g. core_frame.playercount
+    #define core_frame  (*global_core_frame)
+
+    // "make FRAMEBENCH=1" makes every minigame time reading the frame state
+    // against calling into the core when it's loaded. See MINIGAME_INTERFACE
+    #ifndef CORE_FRAME_BENCHMARK
+        #define CORE_FRAME_BENCHMARK  0
+    #endif
+    #if CORE_FRAME_BENCHMARK
+        #define CORE_FRAME_BENCHMARK_LOOPS  10000
+
+        /*==============================
+            core_frame_benchmark
+            Times reading the player count from the frame
+            state against calling core_get_playercount. It's
+            inline so that it runs from the minigame's DSO.
+            The reads go through a volatile pointer so they
+            can't be hoisted out of the loop, and the time
+            of an empty loop is subtracted from both.
+            @param  The name of the minigame
+        ==============================*/
+        static inline void core_frame_benchmark(const char* name)
+        {
+            const volatile CoreFrameState* frame = global_core_frame;
+            volatile uint32_t sink;
+            uint32_t start, empty;
+            int32_t calls, reads;
+
+            start = TICKS_READ();
+            for (int i=0; i<CORE_FRAME_BENCHMARK_LOOPS; i++)
+                sink = i;
+            empty = TICKS_SINCE(start);
+            start = TICKS_READ();
+            for (int i=0; i<CORE_FRAME_BENCHMARK_LOOPS; i++)
+                sink = core_get_playercount();
+            calls = TICKS_SINCE(start) - empty;
+            start = TICKS_READ();
+            for (int i=0; i<CORE_FRAME_BENCHMARK_LOOPS; i++)
+                sink = frame->playercount;
+            reads = TICKS_SINCE(start) - empty;
+            (void)sink;
+            if (calls < 0)
+                calls = 0;
+            if (reads < 0)
+                reads = 0;
+            debugf("Frame state benchmark in %s: core_get_playercount() %lld ns, core_frame read %lld ns\n", name,
+                TICKS_TO_US((uint64_t)calls*1000)/CORE_FRAME_BENCHMARK_LOOPS, TICKS_TO_US((uint64_t)reads*1000)/CORE_FRAME_BENCHMARK_LOOPS);
+        }
+    #endif
+
     
     /***************************************************************
                         Internal Core Functions
                   Do not use anything below this line
     ***************************************************************/
 
+    // The default tick rate. Minigames can change it with .tickrate
     #define TICKRATE   30
     #define DELTATIME  (1.0f/(double)TICKRATE)
 
-    #define MAXPLAYERS  4
-
     void core_set_playercount(uint32_t playercount);
+    void core_set_playercontroller(PlyNum ply, joypad_port_t port);
     void core_set_aidifficulty(AiDiff difficulty);
     void core_set_subtick(double subtick);
+    void core_set_tickrate(uint32_t tickrate);
     void core_reset_winners();
+    bool core_get_winner(PlyNum ply);
+    void core_next_tick();
 
 #endif
\ No newline at end of file
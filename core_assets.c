@@ -0,0 +1,407 @@
+/***************************************************************
+                          core_assets.c
+
+The file contains the shared asset cache, which keeps commonly
+used assets (like the core sounds and fonts) resident between
+minigames instead of loading them again every time. Anything
+else that was released is flushed before each minigame starts.
+***************************************************************/
+
+#include <libdragon.h>
+#include <string.h>
+#include "core.h"
+
+
+/*********************************
+            Structures
+*********************************/
+
+typedef enum {
+    ASSET_WAV64,
+    ASSET_FONT,
+    ASSET_SPRITE,
+    ASSET_ATLAS,
+} AssetType;
+
+// The header mkasset puts in front of compressed files
+typedef struct {
+    char magic[3];
+    uint8_t version;
+    uint16_t level;
+    uint16_t flags;
+    uint32_t storedsize;
+    uint32_t rawsize;
+} AssetHeader;
+
+typedef struct {
+    uint32_t count;
+    uint64_t storedbytes;
+    uint64_t rawbytes;
+    uint64_t readus;
+    uint64_t decompressus;
+} AssetBenchmark;
+
+typedef struct {
+    char* path;
+    AssetType type;
+    void* data;
+    uint32_t refcount;
+    uint32_t bytes;
+} CachedAsset;
+
+
+/*********************************
+             Globals
+*********************************/
+
+// Cache info
+static CachedAsset* global_core_assets = NULL;
+static size_t       global_core_assetcount = 0;
+
+// Statistics
+static uint32_t global_core_assethits = 0;
+static uint32_t global_core_assetmisses = 0;
+
+
+/*==============================
+    core_asset_get
+    Gets an asset from the cache, loading it if needed
+    @param  The path of the asset
+    @param  The type of the asset
+    @return The asset
+==============================*/
+
+static void* core_asset_get(const char* path, AssetType type)
+{
+    heap_stats_t before, after;
+    CachedAsset* asset;
+
+    // Check if the asset is already resident
+    for (size_t i=0; i<global_core_assetcount; i++)
+    {
+        asset = &global_core_assets[i];
+        if (asset->type == type && !strcmp(asset->path, path))
+        {
+            global_core_assethits++;
+            asset->refcount++;
+            return asset->data;
+        }
+    }
+    global_core_assetmisses++;
+
+    // Load it, measuring how much memory it takes
+    global_core_assets = realloc(global_core_assets, sizeof(CachedAsset) * (global_core_assetcount + 1));
+    asset = &global_core_assets[global_core_assetcount++];
+    sys_get_heap_stats(&before);
+    switch (type)
+    {
+        case ASSET_WAV64:
+            asset->data = malloc(sizeof(wav64_t));
+            wav64_open(asset->data, path);
+            break;
+        case ASSET_FONT:
+            asset->data = rdpq_font_load(path);
+            break;
+        case ASSET_SPRITE:
+            asset->data = sprite_load(path);
+            break;
+        case ASSET_ATLAS:
+            asset->data = core_atlas_load(path);
+            break;
+    }
+    sys_get_heap_stats(&after);
+    asset->path = strdup(path);
+    asset->type = type;
+    asset->refcount = 1;
+    asset->bytes = after.used - before.used;
+    return asset->data;
+}
+
+
+/*==============================
+    core_asset_wav64
+    Gets a sound from the shared asset cache
+    @param  The path of the sound
+    @return The sound
+==============================*/
+
+wav64_t* core_asset_wav64(const char* path)
+{
+    return core_asset_get(path, ASSET_WAV64);
+}
+
+
+/*==============================
+    core_asset_font
+    Gets a font from the shared asset cache
+    @param  The path of the font
+    @return The font
+==============================*/
+
+rdpq_font_t* core_asset_font(const char* path)
+{
+    return core_asset_get(path, ASSET_FONT);
+}
+
+
+/*==============================
+    core_asset_sprite
+    Gets a sprite from the shared asset cache
+    @param  The path of the sprite
+    @return The sprite
+==============================*/
+
+sprite_t* core_asset_sprite(const char* path)
+{
+    return core_asset_get(path, ASSET_SPRITE);
+}
+
+
+/*==============================
+    core_asset_atlas
+    Gets an icon atlas from the shared asset cache
+    @param  The path of the atlas
+    @return The atlas
+==============================*/
+
+CoreAtlas* core_asset_atlas(const char* path)
+{
+    return core_asset_get(path, ASSET_ATLAS);
+}
+
+
+/*==============================
+    core_asset_release
+    Releases an asset obtained from the cache
+    @param  The asset to release
+==============================*/
+
+void core_asset_release(void* data)
+{
+    for (size_t i=0; i<global_core_assetcount; i++)
+    {
+        if (global_core_assets[i].data == data)
+        {
+            assertf(global_core_assets[i].refcount > 0, "Asset %s was released too many times\n", global_core_assets[i].path);
+            global_core_assets[i].refcount--;
+            return;
+        }
+    }
+    assertf(false, "Released an asset that isn't in the cache\n");
+}
+
+
+/*==============================
+    core_asset_iskept
+    Checks whether a path is in a keep list
+    @param  The path of the asset
+    @param  A NULL terminated list of paths (can be NULL)
+    @return Whether the path is in the list
+==============================*/
+
+static bool core_asset_iskept(const char* path, const char** keep)
+{
+    if (keep == NULL)
+        return false;
+    for (int i=0; keep[i] != NULL; i++)
+        if (!strcmp(keep[i], path))
+            return true;
+    return false;
+}
+
+
+/*==============================
+    core_asset_flush
+    Frees all the assets which aren't currently in use,
+    except for the ones in the keep list
+    @param  A NULL terminated list of paths to keep
+            resident (can be NULL)
+==============================*/
+
+void core_asset_flush(const char** keep)
+{
+    size_t kept = 0;
+    uint32_t freed = 0;
+    for (size_t i=0; i<global_core_assetcount; i++)
+    {
+        CachedAsset* asset = &global_core_assets[i];
+        if (asset->refcount > 0 || core_asset_iskept(asset->path, keep))
+        {
+            global_core_assets[kept++] = *asset;
+            continue;
+        }
+        freed += asset->bytes;
+        switch (asset->type)
+        {
+            case ASSET_WAV64:
+                wav64_close(asset->data);
+                free(asset->data);
+                break;
+            case ASSET_FONT:
+                rdpq_font_free(asset->data);
+                break;
+            case ASSET_SPRITE:
+                sprite_free(asset->data);
+                break;
+            case ASSET_ATLAS:
+                core_atlas_free(asset->data);
+                break;
+        }
+        free(asset->path);
+    }
+    if (global_core_assetcount != kept)
+        debugf("Asset cache: flushed %d assets, %ld bytes\n", (int)(global_core_assetcount - kept), freed);
+    global_core_assetcount = kept;
+}
+
+
+/*==============================
+    core_asset_get_hits
+    Gets how many requests were served by the cache
+    @return The number of cache hits
+==============================*/
+
+uint32_t core_asset_get_hits()
+{
+    return global_core_assethits;
+}
+
+
+/*==============================
+    core_asset_get_misses
+    Gets how many requests had to load the asset
+    @return The number of cache misses
+==============================*/
+
+uint32_t core_asset_get_misses()
+{
+    return global_core_assetmisses;
+}
+
+
+/*==============================
+    core_asset_get_residentbytes
+    Gets how much memory the resident assets use
+    @return The number of bytes used by the cache
+==============================*/
+
+uint32_t core_asset_get_residentbytes()
+{
+    uint32_t bytes = 0;
+    for (size_t i=0; i<global_core_assetcount; i++)
+        bytes += global_core_assets[i].bytes;
+    return bytes;
+}
+
+
+/*==============================
+    core_asset_benchmark_file
+    Measures how long an asset takes to be read and
+    decompressed, and adds it to the per level totals
+    @param  The path of the asset
+    @param  The per level totals
+==============================*/
+
+static void core_asset_benchmark_file(const char* path, AssetBenchmark* levels)
+{
+    AssetHeader header = {0};
+    uint32_t level = 0, storedsize, rawsize, readus, loadus;
+    FILE* fp;
+    void* data;
+    int size;
+
+    // Time reading the file as it is stored, to tell the reading and decompression apart
+    fp = fopen(path, "rb");
+    if (fp == NULL)
+        return;
+    fseek(fp, 0, SEEK_END);
+    storedsize = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    data = malloc(storedsize);
+    uint32_t start = TICKS_READ();
+    fread(data, 1, storedsize, fp);
+    readus = TICKS_TO_US(TICKS_SINCE(start));
+    fclose(fp);
+    memcpy(&header, data, storedsize < sizeof(header) ? storedsize : sizeof(header));
+    free(data);
+    rawsize = storedsize;
+    if (!memcmp(header.magic, "DCA", 3) && header.level < 4)
+    {
+        level = header.level;
+        rawsize = header.rawsize;
+    }
+
+    // Then time loading it through the asset library
+    start = TICKS_READ();
+    data = asset_load(path, &size);
+    loadus = TICKS_TO_US(TICKS_SINCE(start));
+    free(data);
+
+    levels[level].count++;
+    levels[level].storedbytes += storedsize;
+    levels[level].rawbytes += rawsize;
+    levels[level].readus += readus;
+    levels[level].decompressus += (loadus > readus) ? loadus - readus : 0;
+    debugf("  %-48s level %ld, %7ld -> %7ld bytes, %6ld us read, %6ld us loaded\n", path, level, storedsize, rawsize, readus, loadus);
+}
+
+
+/*==============================
+    core_asset_benchmark_dir
+    Benchmarks every asset in a folder and its subfolders
+    @param  The path of the folder
+    @param  The per level totals
+==============================*/
+
+static void core_asset_benchmark_dir(const char* path, AssetBenchmark* levels)
+{
+    char entry[256];
+    dir_t dir;
+    if (dir_findfirst(path, &dir) < 0)
+        return;
+    do
+    {
+        snprintf(entry, sizeof(entry), "%s%s", path, dir.d_name);
+        if (dir.d_type == DT_DIR)
+        {
+            strncat(entry, "/", sizeof(entry) - strlen(entry) - 1);
+            core_asset_benchmark_dir(entry, levels);
+        }
+        else
+            core_asset_benchmark_file(entry, levels);
+    }
+    while (dir_findnext(path, &dir) == 0);
+}
+
+
+/*==============================
+    core_asset_benchmark
+    Loads every asset in the filesystem and prints the
+    measured ROM read speed and the decompression speed
+    of each compression level
+==============================*/
+
+void core_asset_benchmark()
+{
+    AssetBenchmark levels[4] = {0};
+    uint64_t storedbytes = 0, readus = 0;
+    debugf("Asset benchmark:\n");
+    core_asset_benchmark_dir("rom:/", levels);
+
+    // The read speed is measured over every file, the decompression speed per level
+    for (int i=0; i<4; i++)
+    {
+        storedbytes += levels[i].storedbytes;
+        readus += levels[i].readus;
+    }
+    if (readus > 0)
+        debugf("ROM_KBPS=%lld\n", storedbytes*1000/readus);
+    for (int i=1; i<4; i++)
+    {
+        if (levels[i].count == 0 || levels[i].decompressus == 0)
+            debugf("DECOMP_KBPS_%d: no assets use this level\n", i);
+        else
+            debugf("DECOMP_KBPS_%d=%lld (%ld assets, %lld -> %lld bytes)\n", i, levels[i].rawbytes*1000/levels[i].decompressus,
+                levels[i].count, levels[i].storedbytes, levels[i].rawbytes);
+    }
+}
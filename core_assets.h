@@ -0,0 +1,71 @@
+#ifndef GAMEJAM2024_CORE_ASSETS_H
+#define GAMEJAM2024_CORE_ASSETS_H
+
+    /***************************************************************
+                      Public Core Asset Functions
+    ***************************************************************/
+
+    /*==============================
+        core_asset_wav64
+        Gets a sound from the shared asset cache, opening 
+        it if it isn't resident yet. Release it with 
+        core_asset_release instead of closing it.
+        @param  The path of the sound
+        @return The sound
+    ==============================*/
+    wav64_t* core_asset_wav64(const char* path);
+
+    /*==============================
+        core_asset_font
+        Gets a font from the shared asset cache, loading 
+        it if it isn't resident yet. Since the font is 
+        shared, set the styles you need after getting it. 
+        Release it with core_asset_release instead of 
+        freeing it.
+        @param  The path of the font
+        @return The font
+    ==============================*/
+    rdpq_font_t* core_asset_font(const char* path);
+
+    /*==============================
+        core_asset_sprite
+        Gets a sprite from the shared asset cache, loading 
+        it if it isn't resident yet. Release it with 
+        core_asset_release instead of freeing it.
+        @param  The path of the sprite
+        @return The sprite
+    ==============================*/
+    sprite_t* core_asset_sprite(const char* path);
+
+    /*==============================
+        core_asset_atlas
+        Gets an icon atlas (like CORE_ATLAS_ICONS) from the
+        shared asset cache. Release it with core_asset_release.
+        @param  The path of the atlas
+        @return The atlas
+    ==============================*/
+    CoreAtlas* core_asset_atlas(const char* path);
+
+    /*==============================
+        core_asset_release
+        Releases an asset obtained from the cache. The 
+        core sounds and fonts stay resident so the next game
+        can reuse them, everything else is freed once the
+        next minigame is picked.
+        @param  The asset to release
+    ==============================*/
+    void core_asset_release(void* asset);
+
+    
+    /***************************************************************
+                     Internal Core Asset Functions
+                  Do not use anything below this line
+    ***************************************************************/
+
+    void     core_asset_flush(const char** keep);
+    uint32_t core_asset_get_hits();
+    uint32_t core_asset_get_misses();
+    uint32_t core_asset_get_residentbytes();
+    void     core_asset_benchmark();
+
+#endif
@@ -0,0 +1,147 @@
+/***************************************************************
+                          core_atlas.c
+
+The file contains the texture atlas, which draws icons packed
+by tools/atlaspack.c with one texture upload per page.
+***************************************************************/
+
+#include <libdragon.h>
+#include <string.h>
+#include "core.h"
+
+
+/*********************************
+            Structures
+*********************************/
+
+// The lookup table, followed by the icons
+typedef struct {
+    char     magic[4];
+    uint16_t pagecount;
+    uint16_t iconcount;
+    char     pages[][32];
+} AtlasHeader;
+
+
+/*********************************
+             Globals
+*********************************/
+
+// Statistics
+static uint32_t global_core_atlas_uploads = 0;
+
+
+/*==============================
+    core_atlas_load
+    Loads an atlas and all of its pages
+    @param  The path of the lookup table
+    @return The atlas
+==============================*/
+
+CoreAtlas* core_atlas_load(const char* path)
+{
+    char pagepath[256];
+    int size, dirlen;
+    CoreAtlas* atlas = malloc(sizeof(CoreAtlas));
+    AtlasHeader* header = asset_load(path, &size);
+    assertf(!memcmp(header->magic, "ATLS", 4), "%s is not an atlas\n", path);
+
+    // The pages are next to the lookup table
+    dirlen = strrchr(path, '/') - path + 1;
+    atlas->pagecount = header->pagecount;
+    atlas->iconcount = header->iconcount;
+    atlas->table = header;
+    atlas->icons = (const CoreAtlasIcon*)&header->pages[header->pagecount];
+    atlas->pages = malloc(sizeof(sprite_t*)*atlas->pagecount);
+    for (int i=0; i<atlas->pagecount; i++)
+    {
+        snprintf(pagepath, sizeof(pagepath), "%.*s%s", dirlen, path, header->pages[i]);
+        atlas->pages[i] = sprite_load(pagepath);
+    }
+    atlas->current = -1;
+    return atlas;
+}
+
+
+/*==============================
+    core_atlas_free
+    Frees an atlas and its pages
+    @param  The atlas
+==============================*/
+
+void core_atlas_free(CoreAtlas* atlas)
+{
+    for (int i=0; i<atlas->pagecount; i++)
+        sprite_free(atlas->pages[i]);
+    free(atlas->pages);
+    free(atlas->table);
+    free(atlas);
+}
+
+
+/*==============================
+    core_atlas_find
+    Finds an icon by name
+    @param  The atlas
+    @param  The name of the icon
+    @return The index of the icon
+==============================*/
+
+int core_atlas_find(CoreAtlas* atlas, const char* name)
+{
+    for (int i=0; i<atlas->iconcount; i++)
+        if (!strncmp(atlas->icons[i].name, name, sizeof(atlas->icons[i].name)))
+            return i;
+    assertf(false, "Icon %s is not in the atlas\n", name);
+    return -1;
+}
+
+
+/*==============================
+    core_atlas_begin
+    Sets up the render mode to draw icons
+    @param  The atlas
+==============================*/
+
+void core_atlas_begin(CoreAtlas* atlas)
+{
+    rdpq_set_mode_standard();
+    rdpq_mode_blender(RDPQ_BLENDER_MULTIPLY);
+    atlas->current = -1;
+}
+
+
+/*==============================
+    core_atlas_draw
+    Draws an icon, uploading its page if needed
+    @param  The atlas
+    @param  The index of the icon
+    @param  The X position
+    @param  The Y position
+==============================*/
+
+void core_atlas_draw(CoreAtlas* atlas, int icon, float x, float y)
+{
+    const CoreAtlasIcon* info = &atlas->icons[icon];
+    if (atlas->current != info->page)
+    {
+        rdpq_sprite_upload(TILE0, atlas->pages[info->page], NULL);
+        atlas->current = info->page;
+        global_core_atlas_uploads++;
+    }
+    rdpq_texture_rectangle(TILE0, x, y, x + info->width, y + info->height, info->x, info->y);
+}
+
+
+/*==============================
+    core_atlas_get_uploads
+    Gets how many atlas page uploads were issued. An
+    upload recorded into a block is only counted once,
+    when it's recorded, not every time the block runs
+    @return The number of page uploads issued
+==============================*/
+
+uint32_t core_atlas_get_uploads()
+{
+    return global_core_atlas_uploads;
+}
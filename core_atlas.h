@@ -0,0 +1,79 @@
+#ifndef GAMEJAM2024_CORE_ATLAS_H
+#define GAMEJAM2024_CORE_ATLAS_H
+
+    /***************************************************************
+                      Public Core Atlas Constants
+    ***************************************************************/
+
+    // The core button icons (AButton, CLeft, StartButton, ...), named
+    // after their files in assets/core
+    #define CORE_ATLAS_ICONS  "rom:/core/icons.atlas"
+
+    // Where an icon is in the atlas. Matches the layout written by tools/atlaspack.c
+    typedef struct {
+        char     name[24];
+        uint16_t page;
+        uint16_t x;
+        uint16_t y;
+        uint16_t width;
+        uint16_t height;
+        uint16_t padding;
+    } CoreAtlasIcon;
+
+    // A set of small sprites packed into pages that each fit in TMEM.
+    // Get it with core_asset_atlas and release it with core_asset_release.
+    typedef struct {
+        uint16_t pagecount;
+        uint16_t iconcount;
+        sprite_t** pages;
+        const CoreAtlasIcon* icons;
+        void* table;
+        int current;
+    } CoreAtlas;
+
+
+    /***************************************************************
+                      Public Core Atlas Functions
+    ***************************************************************/
+
+    /*==============================
+        core_atlas_find
+        Finds an icon by name. Do this once, not every frame.
+        @param  The atlas
+        @param  The name of the icon (its file name without the extension)
+        @return The index of the icon
+    ==============================*/
+    int core_atlas_find(CoreAtlas* atlas, const char* name);
+
+    /*==============================
+        core_atlas_begin
+        Sets up the render mode to draw icons. Call this
+        again if something else was drawn with a texture
+        since, as the atlas assumes its page is still in TMEM.
+        @param  The atlas
+    ==============================*/
+    void core_atlas_begin(CoreAtlas* atlas);
+
+    /*==============================
+        core_atlas_draw
+        Draws an icon. The icon's page is only uploaded if
+        it's not the one already in TMEM, so draw icons of
+        the same page together.
+        @param  The atlas
+        @param  The index of the icon
+        @param  The X position
+        @param  The Y position
+    ==============================*/
+    void core_atlas_draw(CoreAtlas* atlas, int icon, float x, float y);
+
+
+    /***************************************************************
+                     Internal Core Atlas Functions
+                  Do not use anything below this line
+    ***************************************************************/
+
+    CoreAtlas* core_atlas_load(const char* path);
+    void       core_atlas_free(CoreAtlas* atlas);
+    uint32_t   core_atlas_get_uploads();
+
+#endif
@@ -0,0 +1,331 @@
+/***************************************************************
+                          core_audio.c
+
+The file contains the voice allocator, which hands out mixer
+channels to sound effects based on their priority and the voice
+budget of the minigame, and the audio pump, which keeps the audio
+buffers filled ahead of time and keeps track of the mixer's cost.
+***************************************************************/
+
+#include <libdragon.h>
+#include "core.h"
+
+
+/*********************************
+             Macros
+*********************************/
+
+// The audio interface's status register, and the bit that says it's playing a buffer
+#define AI_STATUS       ((volatile uint32_t*)0xA450000C)
+#define AI_STATUS_BUSY  (1 << 30)
+
+
+/*********************************
+            Structures
+*********************************/
+
+typedef struct {
+    CoreAudioPriority priority;
+    uint32_t started;
+} Voice;
+
+
+/*********************************
+             Globals
+*********************************/
+
+// Channel info. Reserved channels are given out from channel 0 upwards,
+// sound effect voices from the last channel downwards
+static Voice    global_core_audio_voices[CORE_AUDIO_CHANNELS];
+static int      global_core_audio_channels = 0;
+static int      global_core_audio_frequency = 0;
+static int      global_core_audio_budget = CORE_AUDIO_DEFAULTVOICES;
+static int      global_core_audio_reserved = 0;
+static uint32_t global_core_audio_playcount = 0;
+
+// Statistics
+static int      global_core_audio_peakvoices = 0;
+static uint32_t global_core_audio_stolen = 0;
+static uint32_t global_core_audio_dropped = 0;
+static uint64_t global_core_audio_mixticks = 0;
+static uint32_t global_core_audio_mixmaxticks = 0;
+static uint32_t global_core_audio_mixlastticks = 0;
+static uint32_t global_core_audio_mixcalls = 0;
+static uint32_t global_core_audio_underruns = 0;
+static int32_t  global_core_audio_minahead = CORE_AUDIO_BUFFERS;
+
+
+
+/*==============================
+    core_audio_init
+    Initializes the mixer with the default frequency
+    and channel count
+==============================*/
+
+void core_audio_init()
+{
+    core_audio_configure(0, 0);
+}
+
+
+/*==============================
+    core_audio_configure
+    Initializes the audio again if the frequency or
+    the number of mixer channels changed
+    @param  The frequency, or 0 for the default
+    @param  The number of channels, or 0 for the default
+    @return Whether the audio had to be initialized again
+==============================*/
+
+bool core_audio_configure(int frequency, int channels)
+{
+    if (frequency == 0)
+        frequency = CORE_AUDIO_FREQUENCY;
+    if (channels == 0)
+        channels = CORE_AUDIO_CHANNELS;
+    assertf(channels <= CORE_AUDIO_CHANNELS, "Asked for %d mixer channels, the most is %d\n", channels, CORE_AUDIO_CHANNELS);
+    if (frequency == global_core_audio_frequency && channels == global_core_audio_channels)
+        return false;
+
+    // Shut down the old configuration
+    if (global_core_audio_frequency != 0)
+    {
+        mixer_close();
+        audio_close();
+    }
+    audio_init(frequency, CORE_AUDIO_BUFFERS);
+    mixer_init(channels);
+    global_core_audio_frequency = frequency;
+    global_core_audio_channels = channels;
+    return true;
+}
+
+
+/*==============================
+    core_audio_set_budget
+    Sets how many sound effects the minigame can 
+    play at once
+    @param  The number of voices, or 0 for the default
+            (capped to the number of mixer channels)
+==============================*/
+
+void core_audio_set_budget(int voices)
+{
+    if (voices == 0)
+    {
+        voices = CORE_AUDIO_DEFAULTVOICES;
+        if (voices > global_core_audio_channels)
+            voices = global_core_audio_channels;
+    }
+    assertf(voices <= global_core_audio_channels, "Asked for %d voices, but the mixer only has %d channels\n", voices, global_core_audio_channels);
+    global_core_audio_budget = voices;
+}
+
+
+/*==============================
+    core_audio_play
+    Plays a sound effect on a free voice
+    @param  The sound to play
+    @param  The priority of the sound
+    @return The mixer channel used, or -1
+==============================*/
+
+int core_audio_play(wav64_t* sfx, CoreAudioPriority priority)
+{
+    int chosen = -1;
+    int active = 1;
+    int firstvoice = global_core_audio_channels - global_core_audio_budget;
+    if (firstvoice < global_core_audio_reserved)
+        firstvoice = global_core_audio_reserved;
+
+    // Look for a free voice
+    for (int i=global_core_audio_channels-1; i>=firstvoice; i--)
+    {
+        if (!mixer_ch_playing(i))
+            chosen = i;
+        else
+            active++;
+    }
+
+    // If there isn't one, steal the oldest voice with the lowest priority
+    if (chosen == -1)
+    {
+        for (int i=global_core_audio_channels-1; i>=firstvoice; i--)
+        {
+            Voice* voice = &global_core_audio_voices[i];
+            if (voice->priority > priority)
+                continue;
+            if (chosen == -1 || voice->priority < global_core_audio_voices[chosen].priority ||
+                (voice->priority == global_core_audio_voices[chosen].priority && voice->started < global_core_audio_voices[chosen].started))
+                chosen = i;
+        }
+        if (chosen == -1)
+        {
+            global_core_audio_dropped++;
+            return -1;
+        }
+        global_core_audio_stolen++;
+        active--;
+    }
+
+    // Play the sound
+    global_core_audio_voices[chosen].priority = priority;
+    global_core_audio_voices[chosen].started = global_core_audio_playcount++;
+    if (active > global_core_audio_peakvoices)
+        global_core_audio_peakvoices = active;
+    wav64_play(sfx, chosen);
+    return chosen;
+}
+
+
+/*==============================
+    core_audio_reserve
+    Reserves a block of mixer channels
+    @param  The number of channels needed
+    @return The first reserved channel
+==============================*/
+
+int core_audio_reserve(int count)
+{
+    int first = global_core_audio_reserved;
+    assertf(first + count <= global_core_audio_channels - global_core_audio_budget, "Can't reserve %d channels, only %d are left after the %d sound effect voices\n", count, global_core_audio_channels - global_core_audio_budget - first, global_core_audio_budget);
+    global_core_audio_reserved += count;
+    return first;
+}
+
+
+/*==============================
+    core_audio_get_activevoices
+    Gets how many sound effects are playing
+    @return The number of active voices
+==============================*/
+
+int core_audio_get_activevoices()
+{
+    int active = 0;
+    for (int i=global_core_audio_channels - global_core_audio_budget; i<global_core_audio_channels; i++)
+        if (mixer_ch_playing(i))
+            active++;
+    return active;
+}
+
+
+/*==============================
+    core_audio_get_mixertime
+    Gets how long the mixer took the last time it
+    filled the audio buffers
+    @return The mixer time, in microseconds
+==============================*/
+
+uint32_t core_audio_get_mixertime()
+{
+    return TICKS_TO_US(global_core_audio_mixlastticks);
+}
+
+
+/*==============================
+    core_audio_pump
+    Fills every free audio buffer
+==============================*/
+
+void core_audio_pump()
+{
+    uint32_t start, elapsed;
+    int32_t ahead;
+    int written = 0;
+    if (!audio_can_write())
+        return;
+
+    // If the audio interface isn't playing anything, the queue ran dry since the last pump
+    if (!(*AI_STATUS & AI_STATUS_BUSY))
+        global_core_audio_underruns++;
+
+    // Mix into all the free buffers
+    CORE_TRACE_SCOPE("Audio mix");
+    start = TICKS_READ();
+    while (audio_can_write())
+    {
+        short* buf = audio_write_begin();
+        mixer_poll(buf, audio_get_buffer_length());
+        audio_write_end();
+        written++;
+    }
+    elapsed = TICKS_SINCE(start);
+
+    // The audio library frees a buffer once the audio interface is done with it,
+    // so the buffers that weren't free were still queued (a buffer can free up while mixing)
+    ahead = CORE_AUDIO_BUFFERS - written;
+    if (ahead < 0)
+        ahead = 0;
+    if (ahead < global_core_audio_minahead)
+        global_core_audio_minahead = ahead;
+
+    global_core_audio_mixlastticks = elapsed;
+    global_core_audio_mixticks += elapsed;
+    if (elapsed > global_core_audio_mixmaxticks)
+        global_core_audio_mixmaxticks = elapsed;
+    global_core_audio_mixcalls++;
+}
+
+
+/*==============================
+    core_audio_get_underruns
+    Gets how many times the audio buffers ran dry
+    @return The number of underruns
+==============================*/
+
+uint32_t core_audio_get_underruns()
+{
+    return global_core_audio_underruns;
+}
+
+
+/*==============================
+    core_audio_stopall
+    Stops every mixer channel, including the ones the
+    minigame played on without going through the core,
+    and gives back the reserved channels
+==============================*/
+
+void core_audio_stopall()
+{
+    for (int i=0; i<global_core_audio_channels; i++)
+        mixer_ch_stop(i);
+    global_core_audio_reserved = 0;
+}
+
+
+/*==============================
+    core_audio_report
+    Prints the audio statistics of the last minigame
+==============================*/
+
+void core_audio_report()
+{
+    uint32_t avgus = 0;
+    if (global_core_audio_mixcalls > 0)
+        avgus = TICKS_TO_US(global_core_audio_mixticks/global_core_audio_mixcalls);
+    debugf("Audio: %d/%d voices peak, %ld stolen, %ld dropped, mixer %ld us avg %lld us max\n",
+        global_core_audio_peakvoices, global_core_audio_budget, global_core_audio_stolen, global_core_audio_dropped,
+        avgus, TICKS_TO_US(global_core_audio_mixmaxticks));
+    debugf("Audio buffers: %ld underruns, at least %ld of %d buffers ahead\n",
+        global_core_audio_underruns, global_core_audio_minahead, CORE_AUDIO_BUFFERS);
+}
+
+
+/*==============================
+    core_audio_resetstats
+    Resets the audio statistics
+==============================*/
+
+void core_audio_resetstats()
+{
+    global_core_audio_peakvoices = 0;
+    global_core_audio_stolen = 0;
+    global_core_audio_dropped = 0;
+    global_core_audio_mixticks = 0;
+    global_core_audio_mixmaxticks = 0;
+    global_core_audio_mixcalls = 0;
+    global_core_audio_underruns = 0;
+    global_core_audio_minahead = CORE_AUDIO_BUFFERS;
+}
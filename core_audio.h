@@ -0,0 +1,103 @@
+#ifndef GAMEJAM2024_CORE_AUDIO_H
+#define GAMEJAM2024_CORE_AUDIO_H
+
+    /***************************************************************
+                      Public Core Audio Constants
+    ***************************************************************/
+
+    // The number of mixer channels, unless the minigame asks for fewer
+    #define CORE_AUDIO_CHANNELS  32
+
+    // The default audio output frequency, and how many buffers are queued ahead 
+    // of the audio interface. Each buffer holds about 40ms of audio
+    #define CORE_AUDIO_FREQUENCY  32000
+    #define CORE_AUDIO_BUFFERS    4
+
+    // How many sound effects can play at once if the minigame doesn't say
+    #define CORE_AUDIO_DEFAULTVOICES  8
+
+    // Sound effect priorities. When all the voices are in use, a new
+    // sound steals the voice of the oldest sound with the lowest priority,
+    // as long as that priority isn't higher than its own.
+    typedef enum {
+        AUDIO_PRIORITY_LOW = 0,
+        AUDIO_PRIORITY_NORMAL = 1,
+        AUDIO_PRIORITY_HIGH = 2,
+        AUDIO_PRIORITY_CORE = 3, // Used by the core (countdown, winner, etc...)
+    } CoreAudioPriority;
+
+
+    /***************************************************************
+                      Public Core Audio Functions
+    ***************************************************************/
+
+    /*==============================
+        core_audio_play
+        Plays a sound effect on a free voice, stealing one 
+        if needed
+        @param  The sound to play
+        @param  The priority of the sound
+        @return The mixer channel used, or -1 if the sound 
+                was dropped
+    ==============================*/
+    int core_audio_play(wav64_t* sfx, CoreAudioPriority priority);
+
+    /*==============================
+        core_audio_reserve
+        Reserves a block of mixer channels which won't be 
+        used for sound effects, for instance for XM music:
+        xm64player_play(&music, core_audio_reserve(xm64player_num_channels(&music)));
+        The channels are given back when the minigame ends.
+        @param  The number of channels needed
+        @return The first reserved channel
+    ==============================*/
+    int core_audio_reserve(int count);
+
+    /*==============================
+        core_audio_pump
+        Mixes audio into every free buffer. The core already
+        does this between ticks and around minigame_loop, so
+        you only need to call it if a single frame of yours 
+        can take longer than the queued audio (~120ms), for 
+        example while loading in the middle of a game.
+    ==============================*/
+    void core_audio_pump();
+
+    /*==============================
+        core_audio_get_underruns
+        Gets how many times the audio buffers ran dry 
+        during the current minigame, as seen by the audio
+        interface being idle when the core refilled them
+        @return The number of underruns
+    ==============================*/
+    uint32_t core_audio_get_underruns();
+
+    /*==============================
+        core_audio_get_activevoices
+        Gets how many sound effects are playing
+        @return The number of active voices
+    ==============================*/
+    int core_audio_get_activevoices();
+
+    /*==============================
+        core_audio_get_mixertime
+        Gets how long the mixer took the last time it
+        filled the audio buffers
+        @return The mixer time, in microseconds
+    ==============================*/
+    uint32_t core_audio_get_mixertime();
+
+    
+    /***************************************************************
+                     Internal Core Audio Functions
+                  Do not use anything below this line
+    ***************************************************************/
+
+    void     core_audio_init();
+    bool     core_audio_configure(int frequency, int channels);
+    void     core_audio_set_budget(int voices);
+    void     core_audio_stopall();
+    void     core_audio_report();
+    void     core_audio_resetstats();
+
+#endif
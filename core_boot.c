@@ -0,0 +1,182 @@
+/***************************************************************
+                          core_boot.c
+
+The file contains the boot tracer, which timestamps every step
+of the startup until the first menu frame, and runs the steps
+that were deferred once the menu is up. It only needs a clock
+and printf, so it also builds for the host.
+***************************************************************/
+
+#ifdef __mips__
+    #include <libdragon.h>
+    #define core_boot_now()  ((uint64_t)TICKS_TO_US(get_ticks()))
+    #define core_boot_log    debugf
+#else
+    #include <stdio.h>
+    #include <time.h>
+    #define core_boot_log    printf
+#endif
+#include "core_boot.h"
+
+
+/*********************************
+            Structures
+*********************************/
+
+typedef struct {
+    const char* name;
+    uint64_t at;
+    uint64_t took;
+    bool deferred;
+} BootStep;
+
+
+/*********************************
+             Globals
+*********************************/
+
+// The timeline
+static BootStep global_core_boot_steps[CORE_BOOT_MAXSTEPS];
+static int      global_core_boot_stepcount = 0;
+static uint64_t global_core_boot_last = 0;
+static bool     global_core_boot_reported = false;
+
+// Steps waiting to run
+static const char*  global_core_boot_defernames[CORE_BOOT_MAXSTEPS];
+static CoreBootFunc global_core_boot_deferfuncs[CORE_BOOT_MAXSTEPS];
+static int          global_core_boot_defercount = 0;
+static int          global_core_boot_deferdone = 0;
+
+
+#ifndef __mips__
+/*==============================
+    core_boot_now
+    Gets the time on the host, since the first call
+    @return The time, in microseconds
+==============================*/
+
+static uint64_t core_boot_now()
+{
+    static uint64_t base = 0;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    if (base == 0)
+        base = (uint64_t)ts.tv_sec*1000000 + ts.tv_nsec/1000;
+    return (uint64_t)ts.tv_sec*1000000 + ts.tv_nsec/1000 - base;
+}
+#endif
+
+
+/*==============================
+    core_boot_record
+    Adds a step to the timeline
+    @param  The name of the step
+    @param  When the step started
+    @param  Whether the step was deferred
+==============================*/
+
+static void core_boot_record(const char* name, uint64_t start, bool deferred)
+{
+    uint64_t now = core_boot_now();
+    global_core_boot_last = now;
+    if (global_core_boot_reported || global_core_boot_stepcount == CORE_BOOT_MAXSTEPS)
+        return;
+    global_core_boot_steps[global_core_boot_stepcount].name = name;
+    global_core_boot_steps[global_core_boot_stepcount].at = now;
+    global_core_boot_steps[global_core_boot_stepcount].took = now - start;
+    global_core_boot_steps[global_core_boot_stepcount].deferred = deferred;
+    global_core_boot_stepcount++;
+}
+
+
+/*==============================
+    core_boot_step
+    Marks the end of a boot step, which started when
+    the previous one ended. The first step measures 
+    the time since power on.
+    @param  The name of the step
+==============================*/
+
+void core_boot_step(const char* name)
+{
+    core_boot_record(name, global_core_boot_last, false);
+}
+
+
+/*==============================
+    core_boot_defer
+    Queues a boot step to run once the menu is up.
+    Runs it right away if the boot already finished.
+    @param  The name of the step
+    @param  The function to run
+==============================*/
+
+void core_boot_defer(const char* name, CoreBootFunc func)
+{
+    if (global_core_boot_reported || global_core_boot_defercount == CORE_BOOT_MAXSTEPS)
+    {
+        func();
+        return;
+    }
+    global_core_boot_defernames[global_core_boot_defercount] = name;
+    global_core_boot_deferfuncs[global_core_boot_defercount] = func;
+    global_core_boot_defercount++;
+}
+
+
+/*==============================
+    core_boot_run_deferred
+    Runs the next deferred step, so that each one
+    overlaps a different frame. Dumps the timeline
+    once they're all done.
+    @return Whether there are steps left to run
+==============================*/
+
+bool core_boot_run_deferred()
+{
+    if (global_core_boot_deferdone < global_core_boot_defercount)
+    {
+        int step = global_core_boot_deferdone++;
+        uint64_t start = core_boot_now();
+        global_core_boot_deferfuncs[step]();
+        core_boot_record(global_core_boot_defernames[step], start, true);
+        if (global_core_boot_deferdone < global_core_boot_defercount)
+            return true;
+    }
+    core_boot_report();
+    return false;
+}
+
+
+/*==============================
+    core_boot_finish
+    Runs every deferred step that is left. Call this
+    before anything that needs them.
+==============================*/
+
+void core_boot_finish()
+{
+    while (core_boot_run_deferred())
+        ;
+}
+
+
+/*==============================
+    core_boot_report
+    Dumps the boot timeline, only the first time
+==============================*/
+
+void core_boot_report()
+{
+    if (global_core_boot_reported || global_core_boot_stepcount == 0)
+        return;
+    global_core_boot_reported = true;
+
+    core_boot_log("Boot timeline (ended at, took):\n");
+    for (int i=0; i<global_core_boot_stepcount; i++)
+    {
+        BootStep* step = &global_core_boot_steps[i];
+        core_boot_log("  %9llu us  %9llu us  %s%s\n", (unsigned long long)step->at, (unsigned long long)step->took,
+            step->name, step->deferred ? " (deferred)" : "");
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef GAMEJAM2024_CORE_BOOT_H
+#define GAMEJAM2024_CORE_BOOT_H
+
+    #include <stdint.h>
+    #include <stdbool.h>
+
+    /***************************************************************
+                       Public Core Boot Constants
+    ***************************************************************/
+
+    // The most boot steps (including deferred ones) that are traced
+    #define CORE_BOOT_MAXSTEPS  32
+
+    // A boot step that can run later
+    typedef void (*CoreBootFunc)();
+
+
+    /***************************************************************
+                      Internal Core Boot Functions
+                  Do not use anything below this line
+    ***************************************************************/
+
+    void core_boot_step(const char* name);
+    void core_boot_defer(const char* name, CoreBootFunc func);
+    bool core_boot_run_deferred();
+    void core_boot_finish();
+    void core_boot_report();
+
+#endif
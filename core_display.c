@@ -0,0 +1,86 @@
+/***************************************************************
+                          core_display.c
+
+The file contains the display manager, which keeps the display
+alive between the menu and the minigames, and only reconfigures
+it when the requested mode actually changes.
+***************************************************************/
+
+#include <libdragon.h>
+#include "core.h"
+
+
+/*********************************
+             Globals
+*********************************/
+
+// The mode used by the menu and by minigames that don't declare one
+static const CoreDisplayMode global_core_display_default = {
+    .resolution = RESOLUTION_320x240,
+    .depth = DEPTH_16_BPP,
+    .buffers = 3,
+    .filter = FILTERS_RESAMPLE,
+};
+
+// Display info
+static CoreDisplayMode global_core_display_mode;
+static bool global_core_display_active = false;
+
+
+/*==============================
+    core_display_samemode
+    Checks whether two display modes are the same
+    @param  The first mode
+    @param  The second mode
+    @return Whether the modes match
+==============================*/
+
+static bool core_display_samemode(const CoreDisplayMode* a, const CoreDisplayMode* b)
+{
+    return a->resolution.width == b->resolution.width && a->resolution.height == b->resolution.height &&
+           a->resolution.interlaced == b->resolution.interlaced &&
+           a->depth == b->depth && a->buffers == b->buffers && a->filter == b->filter;
+}
+
+
+/*==============================
+    core_display_set
+    Switches the display to a different mode, keeping
+    the framebuffers if the mode didn't change
+    @param  The display mode, or NULL for the default one
+==============================*/
+
+void core_display_set(const CoreDisplayMode* mode)
+{
+    uint32_t start;
+    if (mode == NULL || mode->buffers == 0)
+        mode = &global_core_display_default;
+
+    // Nothing to do if we're already in this mode
+    if (global_core_display_active && core_display_samemode(&global_core_display_mode, mode))
+        return;
+
+    // Wait for the RDP to be done with the old framebuffers before freeing them
+    start = TICKS_READ();
+    if (global_core_display_active)
+    {
+        rspq_wait();
+        display_close();
+    }
+    display_init(mode->resolution, mode->depth, mode->buffers, GAMMA_NONE, mode->filter);
+    global_core_display_mode = *mode;
+    global_core_display_active = true;
+    debugf("Display set to %ldx%ld in %lld us\n", mode->resolution.width, mode->resolution.height, TICKS_TO_US(TICKS_SINCE(start)));
+}
+
+
+/*==============================
+    core_display_get
+    Gets the current display mode
+    @return The current display mode
+==============================*/
+
+const CoreDisplayMode* core_display_get()
+{
+    return &global_core_display_mode;
+}
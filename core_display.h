@@ -0,0 +1,39 @@
+#ifndef GAMEJAM2024_CORE_DISPLAY_H
+#define GAMEJAM2024_CORE_DISPLAY_H
+
+    /***************************************************************
+                     Public Core Display Constants
+    ***************************************************************/
+
+    // A display mode. Leave buffers at 0 to use the core's default mode
+    // (320x240, 16 bit, 3 buffers, resample filter), which is also what the menu uses.
+    typedef struct {
+        resolution_t resolution;
+        bitdepth_t depth;
+        uint32_t buffers;
+        filter_options_t filter;
+    } CoreDisplayMode;
+
+
+    /***************************************************************
+                     Public Core Display Functions
+    ***************************************************************/
+
+    /*==============================
+        core_display_set
+        Switches the display to a different mode. The framebuffers
+        (and the Z-Buffer) are kept if the mode didn't change.
+        Minigames don't need to call this, the mode declared in 
+        their MinigameDef is set before minigame_init.
+        @param  The display mode, or NULL for the default one
+    ==============================*/
+    void core_display_set(const CoreDisplayMode* mode);
+
+    /*==============================
+        core_display_get
+        Gets the current display mode
+        @return The current display mode
+    ==============================*/
+    const CoreDisplayMode* core_display_get();
+
+#endif
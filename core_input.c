@@ -0,0 +1,183 @@
+/***************************************************************
+                          core_input.c
+
+The file contains the input layer, which reads the controller of
+every human player once per frame, and follows controllers being
+unplugged and plugged back in.
+***************************************************************/
+
+#include <libdragon.h>
+#include <string.h>
+#include "core.h"
+
+
+/*********************************
+             Globals
+*********************************/
+
+// The inputs themselves are stored in global_core_framestate, owned by core.c
+extern CoreFrameState global_core_framestate;
+static bool global_core_input_paused = false;
+
+// Which ports had a controller plugged in last frame
+static uint32_t global_core_input_connected = 0;
+
+
+/*==============================
+    core_input_port_taken
+    Checks whether a controller port is already used
+    by another human player
+    @param  The port to check
+    @param  The player asking
+    @return Whether another player uses the port
+==============================*/
+
+static bool core_input_port_taken(joypad_port_t port, PlyNum ply)
+{
+    for (int i=0; i<core_get_playercount(); i++)
+        if (i != ply && core_get_playercontroller(i) == port)
+            return true;
+    return false;
+}
+
+
+/*==============================
+    core_input_port_shared
+    Checks whether a player's controller port is also
+    used by a player before it. Only the first player
+    on a port gets to use it
+    @param  The port to check
+    @param  The player asking
+    @return Whether an earlier player uses the port
+==============================*/
+
+static bool core_input_port_shared(joypad_port_t port, PlyNum ply)
+{
+    for (int i=0; i<ply; i++)
+        if (core_get_playercontroller(i) == port)
+            return true;
+    return false;
+}
+
+
+/*==============================
+    core_input_get_connected
+    Gets which ports have a controller plugged in
+    @return A bitmask with a bit per port
+==============================*/
+
+static uint32_t core_input_get_connected()
+{
+    uint32_t connected = 0;
+    for (int i=0; i<JOYPAD_PORT_COUNT; i++)
+        if (joypad_is_connected(i))
+            connected |= 1u << i;
+    return connected;
+}
+
+
+/*==============================
+    core_input_reset
+    Remembers which controllers are plugged in, so that
+    only controllers plugged in after this are given to
+    players who lose theirs. Called by the core when the
+    players are assigned their controllers.
+==============================*/
+
+void core_input_reset()
+{
+    global_core_input_connected = core_input_get_connected();
+}
+
+
+/*==============================
+    core_input_update
+    Reads the input of every human player, and remaps
+    players whose controller was unplugged to a newly
+    plugged controller. Idle controllers that were
+    already plugged in are never taken over. Called
+    by the core after joypad_poll.
+==============================*/
+
+void core_input_update()
+{
+    bool paused = false;
+    uint32_t connected = core_input_get_connected();
+    uint32_t plugged = connected & ~global_core_input_connected;
+    global_core_input_connected = connected;
+    for (int i=0; i<MAXPLAYERS; i++)
+    {
+        CoreInput* input = &global_core_framestate.inputs[i];
+        joypad_port_t port;
+        joypad_inputs_t inputs;
+
+        memset(input, 0, sizeof(CoreInput));
+        if (i >= core_get_playercount())
+            continue;
+
+        // If the controller is gone (or belongs to someone else), wait for one to be plugged in
+        port = core_get_playercontroller(i);
+        if (!(connected & (1u << port)) || core_input_port_shared(port, i))
+        {
+            for (int j=0; j<JOYPAD_PORT_COUNT; j++)
+            {
+                if ((plugged & (1u << j)) && !core_input_port_taken(j, i))
+                {
+                    debugf("Player %d moved from port %d to port %d\n", i+1, port+1, j+1);
+                    core_set_playercontroller(i, j);
+                    port = j;
+                    break;
+                }
+            }
+        }
+        if (!(connected & (1u << port)) || core_input_port_shared(port, i))
+        {
+            paused = true;
+            continue;
+        }
+
+        // Decode everything once
+        inputs = joypad_get_inputs(port);
+        input->pressed = joypad_get_buttons_pressed(port);
+        input->held = joypad_get_buttons_held(port);
+        input->released = joypad_get_buttons_released(port);
+        input->stick_x = inputs.stick_x;
+        input->stick_y = inputs.stick_y;
+        input->connected = true;
+    }
+
+    if (paused != global_core_input_paused)
+        debugf(paused ? "Paused, waiting for a controller\n" : "Resumed\n");
+    global_core_input_paused = paused;
+
+    // Don't let anyone play while paused
+    if (paused)
+        for (int i=0; i<MAXPLAYERS; i++)
+            memset(&global_core_framestate.inputs[i], 0, sizeof(CoreInput));
+}
+
+
+/*==============================
+    core_input_get
+    Gets the input of a player for this frame
+    @param  The player we want
+    @return The player's input
+==============================*/
+
+const CoreInput* core_input_get(PlyNum ply)
+{
+    return &global_core_framestate.inputs[ply];
+}
+
+
+/*==============================
+    core_input_is_paused
+    Checks whether the game is paused because a
+    controller was unplugged
+    @return Whether the game is paused
+==============================*/
+
+bool core_input_is_paused()
+{
+    return global_core_input_paused;
+}
@@ -0,0 +1,54 @@
+#ifndef GAMEJAM2024_CORE_INPUT_H
+#define GAMEJAM2024_CORE_INPUT_H
+
+    /***************************************************************
+                      Public Core Input Constants
+    ***************************************************************/
+
+    // The input of a player, read once per frame by the core.
+    // AI players, and players whose controller is unplugged, get
+    // all zeroes.
+    typedef struct {
+        joypad_buttons_t pressed;  // Buttons pressed since the last frame
+        joypad_buttons_t held;     // Buttons currently held
+        joypad_buttons_t released; // Buttons released since the last frame
+        int8_t stick_x;
+        int8_t stick_y;
+        bool   connected;
+    } CoreInput;
+
+
+    /***************************************************************
+                      Public Core Input Functions
+    ***************************************************************/
+
+    /*==============================
+        core_input_get
+        Gets the input of a player for this frame. Use this
+        instead of calling joypad_get_* with the player's 
+        port, since the port can change if the controller
+        is unplugged and plugged into another port.
+        @param  The player we want
+        @return The player's input
+    ==============================*/
+    const CoreInput* core_input_get(PlyNum ply);
+
+    /*==============================
+        core_input_is_paused
+        Checks whether the game is paused because a human
+        player's controller was unplugged. While paused, 
+        the core doesn't call minigame_fixedloop.
+        @return Whether the game is paused
+    ==============================*/
+    bool core_input_is_paused();
+
+    
+    /***************************************************************
+                     Internal Core Input Functions
+                  Do not use anything below this line
+    ***************************************************************/
+
+    void core_input_reset();
+    void core_input_update();
+
+#endif
@@ -0,0 +1,288 @@
+/***************************************************************
+                         core_rdpstats.c
+
+The file contains the RDP statistics, which look at every
+command the RDP runs (through the rdpq debugger) to count the
+commands, render mode changes, syncs and texture uploads of
+each frame.
+***************************************************************/
+
+#include <libdragon.h>
+#include <string.h>
+#include "core.h"
+
+
+/*********************************
+             Macros
+*********************************/
+
+// RDP command IDs
+#define RDP_TRI_FIRST      0x08
+#define RDP_TRI_LAST       0x0F
+#define RDP_TEXRECT        0x24
+#define RDP_TEXRECT_FLIP   0x25
+#define RDP_SYNC_LOAD      0x26
+#define RDP_SYNC_PIPE      0x27
+#define RDP_SYNC_TILE      0x28
+#define RDP_SYNC_FULL      0x29
+#define RDP_SET_OTHERMODES 0x2F
+#define RDP_LOAD_TLUT      0x30
+#define RDP_LOAD_BLOCK     0x33
+#define RDP_LOAD_TILE      0x34
+#define RDP_FILLRECT       0x36
+#define RDP_SET_COMBINE    0x3C
+#define RDP_SET_TEXIMAGE   0x3D
+
+// rdpq's debug command, a no-op for the RDP, and its message subcommand
+// (what rdpq_debug_log_msg writes)
+#define RDPQ_DEBUG         0x31
+#define RDPQ_DEBUG_MESSAGE 0x02
+
+
+/*********************************
+             Globals
+*********************************/
+
+static bool global_core_rdpstats_enabled = false;
+
+// The frame being counted, and the last finished one. Written from the rdpq debugger
+static volatile CoreRdpStats global_core_rdpstats_frame;
+static volatile CoreRdpStats global_core_rdpstats_last;
+static CoreRdpStats          global_core_rdpstats_lastcopy;
+static volatile uint32_t     global_core_rdpstats_teximagesize = 0;
+
+// Queued at the end of every frame, so the hook knows where it ends
+static const char global_core_rdpstats_marker[] = "Frame end";
+
+// Totals since the last reset
+static volatile CoreRdpStats global_core_rdpstats_total;
+static volatile CoreRdpStats global_core_rdpstats_peak;
+static volatile uint32_t     global_core_rdpstats_frames = 0;
+static volatile uint32_t     global_core_rdpstats_histogram[64];
+
+// The overlay
+static CoreText global_core_rdpstats_text;
+
+
+/*==============================
+    core_rdpstats_frame_close
+    Adds the frame that the RDP just went through to
+    the totals. Called by the hook when it reaches
+    the marker that core_rdpstats_frame_end queued.
+==============================*/
+
+static void core_rdpstats_frame_close()
+{
+    volatile uint32_t* frame = (volatile uint32_t*)&global_core_rdpstats_frame;
+    volatile uint32_t* total = (volatile uint32_t*)&global_core_rdpstats_total;
+    volatile uint32_t* peak = (volatile uint32_t*)&global_core_rdpstats_peak;
+
+    disable_interrupts();
+    for (int i=0; i<(int)(sizeof(CoreRdpStats)/sizeof(uint32_t)); i++)
+    {
+        total[i] += frame[i];
+        if (frame[i] > peak[i])
+            peak[i] = frame[i];
+    }
+    global_core_rdpstats_last = global_core_rdpstats_frame;
+    memset((void*)&global_core_rdpstats_frame, 0, sizeof(CoreRdpStats));
+    global_core_rdpstats_frames++;
+    enable_interrupts();
+}
+
+
+/*==============================
+    core_rdpstats_frame_end
+    Marks the end of the frame in the RDP command
+    stream. Called by the core after every 
+    minigame_loop, since a frame can detach from the
+    display (and do a full sync) more than once. The
+    RDP runs behind the CPU, so the frame is only
+    added to the totals once the hook gets there.
+==============================*/
+
+void core_rdpstats_frame_end()
+{
+    if (!global_core_rdpstats_enabled)
+        return;
+    rdpq_debug_log_msg(global_core_rdpstats_marker);
+}
+
+
+/*==============================
+    core_rdpstats_hook
+    Called by the rdpq debugger for every RDP command
+    @param  Unused
+    @param  The command
+    @param  The size of the command, in 64-bit words
+==============================*/
+
+static void core_rdpstats_hook(void* ctx, uint64_t* cmd, int size)
+{
+    volatile CoreRdpStats* frame = &global_core_rdpstats_frame;
+    uint64_t c = cmd[0];
+    int id = (c >> 56) & 0x3F;
+    uint32_t texels;
+
+    if (id == RDPQ_DEBUG)
+    {
+        if (((c >> 48) & 0xFF) == RDPQ_DEBUG_MESSAGE && (c & 0xFFFFFF) == (PhysicalAddr(global_core_rdpstats_marker) & 0xFFFFFF))
+            core_rdpstats_frame_close();
+        return;
+    }
+
+    frame->commands++;
+    frame->bytes += size*8;
+    global_core_rdpstats_histogram[id]++;
+    switch (id)
+    {
+        case RDP_TEXRECT:
+        case RDP_TEXRECT_FLIP:
+        case RDP_FILLRECT:
+            frame->rectangles++;
+            break;
+        case RDP_SYNC_LOAD:
+        case RDP_SYNC_PIPE:
+        case RDP_SYNC_TILE:
+        case RDP_SYNC_FULL:
+            frame->syncs++;
+            break;
+        case RDP_SET_OTHERMODES:
+        case RDP_SET_COMBINE:
+            frame->modechanges++;
+            break;
+        case RDP_SET_TEXIMAGE:
+            global_core_rdpstats_teximagesize = (c >> 51) & 0x3;
+            break;
+        case RDP_LOAD_TLUT:
+            frame->uploads++;
+            frame->uploadbytes += ((((c >> 12) & 0xFFF) - ((c >> 44) & 0xFFF)) >> 2) * 2 + 2;
+            break;
+        case RDP_LOAD_BLOCK:
+            texels = ((c >> 12) & 0xFFF) - ((c >> 44) & 0xFFF) + 1;
+            frame->uploads++;
+            frame->uploadbytes += (texels << global_core_rdpstats_teximagesize) >> 1;
+            break;
+        case RDP_LOAD_TILE:
+            texels = (((((c >> 12) & 0xFFF) - ((c >> 44) & 0xFFF)) >> 2) + 1) * ((((c & 0xFFF) - ((c >> 32) & 0xFFF)) >> 2) + 1);
+            frame->uploads++;
+            frame->uploadbytes += (texels << global_core_rdpstats_teximagesize) >> 1;
+            break;
+        default:
+            if (id >= RDP_TRI_FIRST && id <= RDP_TRI_LAST)
+                frame->triangles++;
+            break;
+    }
+}
+
+
+/*==============================
+    core_rdpstats_init
+    Starts counting the RDP commands. The rdpq
+    debugger must be running.
+==============================*/
+
+void core_rdpstats_init()
+{
+    rdpq_debug_install_hook(core_rdpstats_hook, NULL);
+    rdpq_text_register_font(CORE_RDPSTATS_FONT, rdpq_font_load_builtin(FONT_BUILTIN_DEBUG_MONO));
+    global_core_rdpstats_enabled = true;
+}
+
+
+/*==============================
+    core_rdpstats_get_lastframe
+    Gets the RDP statistics of the last finished frame
+    @return The statistics of the last frame
+==============================*/
+
+const CoreRdpStats* core_rdpstats_get_lastframe()
+{
+    disable_interrupts();
+    global_core_rdpstats_lastcopy = global_core_rdpstats_last;
+    enable_interrupts();
+    return &global_core_rdpstats_lastcopy;
+}
+
+
+/*==============================
+    core_rdpstats_draw
+    Draws the statistics of the last frame
+==============================*/
+
+void core_rdpstats_draw()
+{
+    const CoreRdpStats* last;
+    if (!global_core_rdpstats_enabled)
+        return;
+    last = core_rdpstats_get_lastframe();
+    rdpq_set_mode_standard();
+    core_text_printf(&global_core_rdpstats_text, NULL, CORE_RDPSTATS_FONT, 8, 12,
+        "RDP %ld cmd %ldB  mode %ld sync %ld\nTEX %ld %ldB  tri %ld rect %ld",
+        last->commands, last->bytes, last->modechanges, last->syncs,
+        last->uploads, last->uploadbytes, last->triangles, last->rectangles);
+}
+
+
+/*==============================
+    core_rdpstats_reset
+    Resets the totals and the frame being counted,
+    for instance before a minigame
+==============================*/
+
+void core_rdpstats_reset()
+{
+    disable_interrupts();
+    memset((void*)&global_core_rdpstats_frame, 0, sizeof(CoreRdpStats));
+    memset((void*)&global_core_rdpstats_total, 0, sizeof(CoreRdpStats));
+    memset((void*)&global_core_rdpstats_peak, 0, sizeof(CoreRdpStats));
+    memset((void*)global_core_rdpstats_histogram, 0, sizeof(global_core_rdpstats_histogram));
+    global_core_rdpstats_frames = 0;
+    enable_interrupts();
+}
+
+
+/*==============================
+    core_rdpstats_report
+    Prints the totals since the last reset to the
+    debug log, one "RDPSTATS" line per value so it's
+    easy to pick up from the host
+    @param  The name to print the totals under
+==============================*/
+
+void core_rdpstats_report(const char* name)
+{
+    static const struct {
+        int id;
+        const char* name;
+    } commands[] = {
+        {RDP_TEXRECT, "TEXTURE_RECTANGLE"}, {RDP_TEXRECT_FLIP, "TEXTURE_RECTANGLE_FLIP"},
+        {RDP_SYNC_LOAD, "SYNC_LOAD"}, {RDP_SYNC_PIPE, "SYNC_PIPE"}, {RDP_SYNC_TILE, "SYNC_TILE"},
+        {RDP_SYNC_FULL, "SYNC_FULL"}, {RDP_SET_OTHERMODES, "SET_OTHER_MODES"}, {RDP_LOAD_TLUT, "LOAD_TLUT"},
+        {RDP_LOAD_BLOCK, "LOAD_BLOCK"}, {RDP_LOAD_TILE, "LOAD_TILE"}, {RDP_FILLRECT, "FILL_RECTANGLE"},
+        {RDP_SET_COMBINE, "SET_COMBINE"}, {RDP_SET_TEXIMAGE, "SET_TEXTURE_IMAGE"},
+    };
+    CoreRdpStats total, peak;
+    uint32_t frames;
+    if (!global_core_rdpstats_enabled)
+        return;
+
+    disable_interrupts();
+    total = global_core_rdpstats_total;
+    peak = global_core_rdpstats_peak;
+    frames = global_core_rdpstats_frames;
+    enable_interrupts();
+    if (frames == 0)
+        return;
+
+    debugf("RDPSTATS %s frames %ld\n", name, frames);
+    debugf("RDPSTATS %s average commands %ld bytes %ld modechanges %ld syncs %ld uploads %ld uploadbytes %ld triangles %ld rectangles %ld\n",
+        name, total.commands/frames, total.bytes/frames, total.modechanges/frames, total.syncs/frames,
+        total.uploads/frames, total.uploadbytes/frames, total.triangles/frames, total.rectangles/frames);
+    debugf("RDPSTATS %s peak commands %ld bytes %ld modechanges %ld syncs %ld uploads %ld uploadbytes %ld triangles %ld rectangles %ld\n",
+        name, peak.commands, peak.bytes, peak.modechanges, peak.syncs,
+        peak.uploads, peak.uploadbytes, peak.triangles, peak.rectangles);
+    for (int i=0; i<(int)(sizeof(commands)/sizeof(commands[0])); i++)
+        if (global_core_rdpstats_histogram[commands[i].id] > 0)
+            debugf("RDPSTATS %s command %s %ld per frame\n", name, commands[i].name, global_core_rdpstats_histogram[commands[i].id]/frames);
+}
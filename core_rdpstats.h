@@ -0,0 +1,58 @@
+#ifndef GAMEJAM2024_CORE_RDPSTATS_H
+#define GAMEJAM2024_CORE_RDPSTATS_H
+
+    /***************************************************************
+                     Public Core RDP Stats Constants
+    ***************************************************************/
+
+    // The font ID the overlay registers. It's the last one, so it
+    // shouldn't clash with the fonts of the minigames
+    #define CORE_RDPSTATS_FONT  15
+
+    // What the RDP was asked to do in one frame
+    typedef struct {
+        uint32_t commands;
+        uint32_t bytes;
+        uint32_t modechanges;  // Render mode and combiner changes
+        uint32_t syncs;        // Pipe, tile, load and full syncs
+        uint32_t uploads;      // Texture and palette loads
+        uint32_t uploadbytes;
+        uint32_t triangles;
+        uint32_t rectangles;
+    } CoreRdpStats;
+
+
+    /***************************************************************
+                     Public Core RDP Stats Functions
+    ***************************************************************/
+
+    /*==============================
+        core_rdpstats_get_lastframe
+        Gets the RDP statistics of the last finished
+        frame. Only counted when RDP_STATS is set in 
+        config.h, otherwise they're all zero.
+        @return The statistics of the last frame
+    ==============================*/
+    const CoreRdpStats* core_rdpstats_get_lastframe();
+
+    /*==============================
+        core_rdpstats_draw
+        Draws the statistics of the last frame on top of
+        the screen. core_round_draw_hud already does this,
+        so only call it if you don't use the round HUD.
+        Does nothing unless RDP_STATS is set in config.h.
+    ==============================*/
+    void core_rdpstats_draw();
+
+
+    /***************************************************************
+                    Internal Core RDP Stats Functions
+                  Do not use anything below this line
+    ***************************************************************/
+
+    void core_rdpstats_init();
+    void core_rdpstats_reset();
+    void core_rdpstats_frame_end();
+    void core_rdpstats_report(const char* name);
+
+#endif
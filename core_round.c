@@ -0,0 +1,268 @@
+/***************************************************************
+                          core_round.c
+
+The file contains the round state engine, which handles the
+countdown, start, end and winner announcement that every
+minigame round goes through.
+***************************************************************/
+
+#include <libdragon.h>
+#include "core.h"
+#include "minigame.h"
+
+
+/*********************************
+             Globals
+*********************************/
+
+// Round info
+static bool            global_core_round_active = false;
+static CoreRoundParams global_core_round_params;
+static CoreRoundPhase  global_core_round_phase;
+static CoreRoundEvent  global_core_round_events;
+static uint32_t        global_core_round_ticks;
+
+// Sounds, opened once at boot
+static wav64_t* global_core_round_sfx_start;
+static wav64_t* global_core_round_sfx_countdown;
+static wav64_t* global_core_round_sfx_stop;
+static wav64_t* global_core_round_sfx_winner;
+
+// HUD
+static CoreText global_core_round_text;
+
+// Used when no round parameters are given, in seconds
+#define CORE_ROUND_DEFAULT_COUNTDOWN   3
+#define CORE_ROUND_DEFAULT_GO          1
+#define CORE_ROUND_DEFAULT_WINNERSHOW  2
+#define CORE_ROUND_DEFAULT_END         5
+
+static const char* global_core_round_phasenames[] = {"countdown", "go", "playing", "ending", "winner"};
+
+
+/*==============================
+    core_round_setphase
+    Changes the phase of the round
+    @param  The new phase
+==============================*/
+
+static void core_round_setphase(CoreRoundPhase phase)
+{
+    global_core_round_phase = phase;
+    global_core_round_ticks = 0;
+    debugf("Round phase: %s\n", global_core_round_phasenames[phase]);
+}
+
+
+/*==============================
+    core_round_init
+    Opens the sounds used by the rounds
+==============================*/
+
+void core_round_init()
+{
+    global_core_round_sfx_start = core_asset_wav64("rom:/core/Start.wav64");
+    global_core_round_sfx_countdown = core_asset_wav64("rom:/core/Countdown.wav64");
+    global_core_round_sfx_stop = core_asset_wav64("rom:/core/Stop.wav64");
+    global_core_round_sfx_winner = core_asset_wav64("rom:/core/Winner.wav64");
+}
+
+
+/*==============================
+    core_round_start
+    Starts the round, beginning with the countdown
+    @param  The phase lengths (can be NULL)
+==============================*/
+
+void core_round_start(const CoreRoundParams* params)
+{
+    if (params == NULL)
+    {
+        global_core_round_params = (CoreRoundParams){
+            .countdown  = CORE_ROUND_SECONDS(CORE_ROUND_DEFAULT_COUNTDOWN),
+            .go         = CORE_ROUND_SECONDS(CORE_ROUND_DEFAULT_GO),
+            .winnershow = CORE_ROUND_SECONDS(CORE_ROUND_DEFAULT_WINNERSHOW),
+            .end        = CORE_ROUND_SECONDS(CORE_ROUND_DEFAULT_END),
+        };
+    }
+    else
+        global_core_round_params = *params;
+    global_core_round_events = ROUNDEVENT_NONE;
+    global_core_round_active = true;
+    core_round_setphase(ROUND_COUNTDOWN);
+}
+
+
+/*==============================
+    core_round_finish
+    Ends the round
+==============================*/
+
+void core_round_finish()
+{
+    if (!global_core_round_active || global_core_round_phase >= ROUND_ENDING)
+        return;
+    core_round_setphase(ROUND_ENDING);
+    global_core_round_events |= ROUNDEVENT_STOP;
+    core_audio_play(global_core_round_sfx_stop, AUDIO_PRIORITY_CORE);
+}
+
+
+/*==============================
+    core_round_tick
+    Advances the round by one tick. Called by the core
+    before every minigame_fixedloop
+==============================*/
+
+void core_round_tick()
+{
+    const CoreRoundParams* params = &global_core_round_params;
+    CoreRoundPhase phase = global_core_round_phase;
+    global_core_round_events = ROUNDEVENT_NONE;
+    if (!global_core_round_active)
+        return;
+
+    switch (global_core_round_phase)
+    {
+        case ROUND_COUNTDOWN:
+            if (global_core_round_ticks >= params->countdown)
+            {
+                core_round_setphase(ROUND_GO);
+                global_core_round_events |= ROUNDEVENT_START;
+                core_audio_play(global_core_round_sfx_start, AUDIO_PRIORITY_CORE);
+            }
+            else if (global_core_round_ticks % core_get_tickrate() == 0)
+            {
+                global_core_round_events |= ROUNDEVENT_COUNTDOWN;
+                core_audio_play(global_core_round_sfx_countdown, AUDIO_PRIORITY_CORE);
+            }
+            break;
+        case ROUND_GO:
+            if (global_core_round_ticks >= params->go)
+                core_round_setphase(ROUND_PLAYING);
+            break;
+        case ROUND_PLAYING:
+            break;
+        case ROUND_ENDING:
+            if (global_core_round_ticks >= params->winnershow)
+            {
+                core_round_setphase(ROUND_WINNER);
+                global_core_round_ticks = params->winnershow;
+                global_core_round_events |= ROUNDEVENT_WINNER;
+                core_audio_play(global_core_round_sfx_winner, AUDIO_PRIORITY_CORE);
+            }
+            break;
+        case ROUND_WINNER:
+            // The tick count carries over from the ending phase, so the end delay is measured from core_round_finish
+            if (global_core_round_ticks >= params->end)
+            {
+                global_core_round_events |= ROUNDEVENT_FINISHED;
+                global_core_round_active = false;
+                minigame_end();
+            }
+            break;
+    }
+
+    // The tick that changed the phase already counts as its first one
+    if (global_core_round_phase == phase)
+        global_core_round_ticks++;
+}
+
+
+/*==============================
+    core_round_get_phase
+    Gets the current phase of the round
+    @return The current phase
+==============================*/
+
+CoreRoundPhase core_round_get_phase()
+{
+    return global_core_round_phase;
+}
+
+
+/*==============================
+    core_round_get_events
+    Gets the events fired by the round this tick
+    @return The events, OR'd together
+==============================*/
+
+CoreRoundEvent core_round_get_events()
+{
+    return global_core_round_events;
+}
+
+
+/*==============================
+    core_round_can_control
+    Checks whether the players are allowed to play
+    @return Whether the players can play
+==============================*/
+
+bool core_round_can_control()
+{
+    return global_core_round_phase == ROUND_GO || global_core_round_phase == ROUND_PLAYING;
+}
+
+
+/*==============================
+    core_round_draw_hud
+    Draws the countdown, "GO!" or the winners
+    @param  The font ID to use
+==============================*/
+
+void core_round_draw_hud(uint8_t font)
+{
+    char buff[CORE_TEXT_MAXLEN];
+    rdpq_textparms_t parms = {
+        .align = ALIGN_CENTER,
+        .width = core_display_get()->resolution.width,
+    };
+
+    // The RDP statistics overlay, if they are enabled
+    core_rdpstats_draw();
+
+    // Build the string for the current phase, so that it's all drawn with a single layout
+    switch (global_core_round_phase)
+    {
+        case ROUND_COUNTDOWN:
+        {
+            uint32_t ticksleft = global_core_round_params.countdown - global_core_round_ticks;
+            sprintf(buff, "%ld", (ticksleft + core_get_tickrate() - 1)/core_get_tickrate());
+            break;
+        }
+        case ROUND_GO:
+            sprintf(buff, "GO!");
+            break;
+        case ROUND_WINNER:
+        {
+            int len = 0;
+            for (int i=0; i<MAXPLAYERS; i++)
+                if (core_get_winner(i))
+                    len += sprintf(buff + len, "Player %d wins!\n", i+1);
+            if (len == 0)
+                return;
+            break;
+        }
+        default:
+            return;
+    }
+
+    rdpq_set_mode_standard();
+    core_text_print(&global_core_round_text, &parms, font, 0, 100, buff);
+}
+
+
+/*==============================
+    core_round_stop
+    Stops the round and frees the HUD. Called by the 
+    core after minigame_cleanup
+==============================*/
+
+void core_round_stop()
+{
+    global_core_round_active = false;
+    global_core_round_phase = ROUND_COUNTDOWN;
+    global_core_round_events = ROUNDEVENT_NONE;
+    core_text_free(&global_core_round_text);
+}
@@ -0,0 +1,103 @@
+#ifndef GAMEJAM2024_CORE_ROUND_H
+#define GAMEJAM2024_CORE_ROUND_H
+
+    /***************************************************************
+                      Public Core Round Constants
+    ***************************************************************/
+
+    // Converts a time in seconds to a number of ticks at the minigame's tick rate
+    #define CORE_ROUND_SECONDS(s)  ((uint32_t)((s)*core_get_tickrate()))
+
+    // The phases of a round
+    typedef enum {
+        ROUND_COUNTDOWN = 0, // Counting down, players can't move yet
+        ROUND_GO,            // "GO!" is being shown, players can move
+        ROUND_PLAYING,       // The round is being played
+        ROUND_ENDING,        // The round is over, waiting to show the winners
+        ROUND_WINNER,        // The winners are being shown
+    } CoreRoundPhase;
+
+    // Events fired by the round during the last tick (can be OR'd together)
+    typedef enum {
+        ROUNDEVENT_NONE      = 0,
+        ROUNDEVENT_COUNTDOWN = 1 << 0, // A second of the countdown started
+        ROUNDEVENT_START     = 1 << 1, // The players got control
+        ROUNDEVENT_STOP      = 1 << 2, // core_round_finish was called
+        ROUNDEVENT_WINNER    = 1 << 3, // The winners started being shown
+        ROUNDEVENT_FINISHED  = 1 << 4, // The minigame is about to end
+    } CoreRoundEvent;
+
+    // The length of each phase, in ticks
+    typedef struct {
+        uint32_t countdown;  // Ticks before the players get control
+        uint32_t go;         // Ticks "GO!" stays on screen
+        uint32_t winnershow; // Ticks between core_round_finish and the winner announcement
+        uint32_t end;        // Ticks between core_round_finish and the end of the minigame
+    } CoreRoundParams;
+
+
+    /***************************************************************
+                      Public Core Round Functions
+    ***************************************************************/
+
+    /*==============================
+        core_round_start
+        Starts the round, beginning with the countdown. Call 
+        this in minigame_init. From then on, the core ticks 
+        the round before every call to minigame_fixedloop, 
+        plays the countdown/start/stop/winner sounds and 
+        calls minigame_end when the round is over.
+        @param  The phase lengths, or NULL for the default
+                ones (3s countdown, 1s GO, winners shown 
+                2s after the end, minigame ends 5s after)
+    ==============================*/
+    void core_round_start(const CoreRoundParams* params);
+
+    /*==============================
+        core_round_finish
+        Ends the round. Set the winners with core_set_winner
+        before calling this. Calling it again does nothing.
+    ==============================*/
+    void core_round_finish();
+
+    /*==============================
+        core_round_get_phase
+        Gets the current phase of the round
+        @return The current phase
+    ==============================*/
+    CoreRoundPhase core_round_get_phase();
+
+    /*==============================
+        core_round_get_events
+        Gets the events fired by the round this tick
+        @return The events, OR'd together
+    ==============================*/
+    CoreRoundEvent core_round_get_events();
+
+    /*==============================
+        core_round_can_control
+        Checks whether the players are allowed to play
+        @return True during the GO and playing phases
+    ==============================*/
+    bool core_round_can_control();
+
+    /*==============================
+        core_round_draw_hud
+        Draws the countdown, "GO!" or the winners, centered 
+        on the screen, with a single text layout. Call it 
+        while attached, after drawing your game.
+        @param  The font ID to use
+    ==============================*/
+    void core_round_draw_hud(uint8_t font);
+
+    
+    /***************************************************************
+                     Internal Core Round Functions
+                  Do not use anything below this line
+    ***************************************************************/
+
+    void core_round_init();
+    void core_round_tick();
+    void core_round_stop();
+
+#endif
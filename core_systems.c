@@ -0,0 +1,118 @@
+/***************************************************************
+                          core_systems.c
+
+The file contains the subsystem manager, which starts the 
+subsystems a minigame asks for and keeps them running between
+minigames that share them, instead of every minigame setting
+them up and tearing them down again.
+***************************************************************/
+
+#include <libdragon.h>
+#include <GL/gl.h>
+#include <GL/gl_integration.h>
+#include <t3d/t3d.h>
+#include "core.h"
+
+
+/*********************************
+            Structures
+*********************************/
+
+typedef struct {
+    uint32_t flag;
+    const char* name;
+    void (*start)();
+    void (*stop)();
+    uint32_t startus;
+    uint32_t stopus;
+} CoreSystem;
+
+
+/*********************************
+        Function Prototypes
+*********************************/
+
+static void core_systems_start_t3d();
+
+
+/*********************************
+             Globals
+*********************************/
+
+// The subsystems, and how long they took to start and stop the last time
+static CoreSystem global_core_systems[] = {
+    {CORE_SYSTEM_GL, "GL", gl_init, gl_close, 0, 0},
+    {CORE_SYSTEM_T3D, "T3D", core_systems_start_t3d, t3d_destroy, 0, 0},
+};
+static uint32_t global_core_systems_running = 0;
+
+// Statistics
+static uint64_t global_core_systems_saved = 0;
+
+
+/*==============================
+    core_systems_start_t3d
+    Starts Tiny3D with the default parameters
+==============================*/
+
+static void core_systems_start_t3d()
+{
+    t3d_init((T3DInitParams){});
+}
+
+
+/*==============================
+    core_systems_set
+    Starts and stops subsystems so that only the ones
+    the next minigame needs are running, and sets up 
+    the audio for it
+    @param  The CORE_SYSTEM_* flags of the minigame
+    @param  The audio frequency, or 0 for the default
+    @param  The number of mixer channels, or 0 for the default
+==============================*/
+
+void core_systems_set(uint32_t systems, int frequency, int channels)
+{
+    uint32_t start, spent = 0, saved = 0;
+
+    for (int i=0; i<(int)(sizeof(global_core_systems)/sizeof(global_core_systems[0])); i++)
+    {
+        CoreSystem* sys = &global_core_systems[i];
+        bool wanted = (systems & sys->flag) != 0;
+        bool running = (global_core_systems_running & sys->flag) != 0;
+        start = TICKS_READ();
+        if (wanted && !running)
+        {
+            sys->start();
+            sys->startus = TICKS_TO_US(TICKS_SINCE(start));
+            spent += sys->startus;
+            global_core_systems_running |= sys->flag;
+            debugf("Subsystems: started %s in %ld us\n", sys->name, sys->startus);
+        }
+        else if (!wanted && running)
+        {
+            sys->stop();
+            sys->stopus = TICKS_TO_US(TICKS_SINCE(start));
+            spent += sys->stopus;
+            global_core_systems_running &= ~sys->flag;
+            debugf("Subsystems: stopped %s in %ld us\n", sys->name, sys->stopus);
+        }
+        else if (wanted && running)
+        {
+            // The minigame would have started it, and the previous one would have stopped it
+            saved += sys->startus + sys->stopus;
+        }
+    }
+
+    // The audio is always running, it only needs to be set up again if the format changed
+    start = TICKS_READ();
+    if (core_audio_configure(frequency, channels))
+    {
+        uint32_t audious = TICKS_TO_US(TICKS_SINCE(start));
+        spent += audious;
+        debugf("Subsystems: audio set up again in %ld us\n", audious);
+    }
+
+    global_core_systems_saved += saved;
+    debugf("Subsystems: %ld us spent, %ld us saved by keeping them running (%lld us in total)\n", spent, saved, global_core_systems_saved);
+}
@@ -0,0 +1,23 @@
+#ifndef GAMEJAM2024_CORE_SYSTEMS_H
+#define GAMEJAM2024_CORE_SYSTEMS_H
+
+    /***************************************************************
+                     Public Core Systems Constants
+    ***************************************************************/
+
+    // Subsystems a minigame can ask the core to have running, through the
+    // systems field of its MinigameDef. They stay running between minigames
+    // that share them, so their state isn't reset: set up everything you use
+    // in minigame_init, and don't call their init or close functions yourself.
+    #define CORE_SYSTEM_GL   (1 << 0)  // OpenGL (gl_init)
+    #define CORE_SYSTEM_T3D  (1 << 1)  // Tiny3D (t3d_init with the default parameters)
+
+
+    /***************************************************************
+                     Internal Core Systems Functions
+                  Do not use anything below this line
+    ***************************************************************/
+
+    void core_systems_set(uint32_t systems, int frequency, int channels);
+
+#endif
@@ -0,0 +1,157 @@
+/***************************************************************
+                           core_text.c
+
+The file contains the retained text layer, which caches the glyph
+layout of strings so that they are only laid out again when they
+actually change.
+***************************************************************/
+
+#include <libdragon.h>
+#include <string.h>
+#include <stdarg.h>
+#include "core.h"
+
+
+/*********************************
+             Globals
+*********************************/
+
+// Statistics
+static uint32_t global_core_text_built = 0;
+static uint32_t global_core_text_avoided = 0;
+
+// Used when no text parameters are given
+static const rdpq_textparms_t global_core_text_noparms = {0};
+
+
+/*==============================
+    core_text_sameparms
+    Checks whether two sets of text parameters produce
+    the same layout
+    @param  The first set of parameters
+    @param  The second set of parameters
+    @return Whether the parameters match
+==============================*/
+
+static bool core_text_sameparms(const rdpq_textparms_t* a, const rdpq_textparms_t* b)
+{
+    return a->width == b->width && a->height == b->height &&
+           a->align == b->align && a->valign == b->valign &&
+           a->indent == b->indent && a->max_chars == b->max_chars &&
+           a->char_spacing == b->char_spacing && a->line_spacing == b->line_spacing &&
+           a->wrap == b->wrap && a->tabstops == b->tabstops &&
+           a->style_id == b->style_id;
+}
+
+
+/*==============================
+    core_text_print
+    Draws a string, reusing the previous layout
+    of this text if nothing has changed
+    @param  The cached text
+    @param  The text parameters (can be NULL)
+    @param  The font ID
+    @param  The X position
+    @param  The Y position
+    @param  The string to draw
+    @return The metrics of the drawn text
+==============================*/
+
+rdpq_textmetrics_t core_text_print(CoreText* text, const rdpq_textparms_t* parms, uint8_t font, float x, float y, const char* str)
+{
+    if (parms == NULL)
+        parms = &global_core_text_noparms;
+    assertf(strlen(str) < CORE_TEXT_MAXLEN, "Text is longer than %d characters: %s\n", CORE_TEXT_MAXLEN-1, str);
+
+    // Only lay out the text again if something changed
+    if (text->layout != NULL && text->font == font && core_text_sameparms(&text->parms, parms) && !strcmp(text->text, str))
+    {
+        global_core_text_avoided++;
+    }
+    else
+    {
+        int nbytes;
+        if (text->layout != NULL)
+            rdpq_paragraph_free(text->layout);
+        strcpy(text->text, str);
+        text->parms = *parms;
+        text->font = font;
+        nbytes = strlen(text->text);
+        text->layout = rdpq_paragraph_build(parms, font, text->text, &nbytes);
+        global_core_text_built++;
+    }
+
+    // Draw the cached layout
+    rdpq_paragraph_render(text->layout, x, y);
+    return (rdpq_textmetrics_t){
+        .advance_x = text->layout->advance_x,
+        .advance_y = text->layout->advance_y,
+        .utf8_text_advance = strlen(text->text),
+    };
+}
+
+
+/*==============================
+    core_text_printf
+    Same as core_text_print, but with a format string
+    @param  The cached text
+    @param  The text parameters (can be NULL)
+    @param  The font ID
+    @param  The X position
+    @param  The Y position
+    @param  The format string
+    @param  The format arguments
+    @return The metrics of the drawn text
+==============================*/
+
+rdpq_textmetrics_t core_text_printf(CoreText* text, const rdpq_textparms_t* parms, uint8_t font, float x, float y, const char* fmt, ...)
+{
+    char buf[CORE_TEXT_MAXLEN];
+    int len;
+    va_list args;
+    va_start(args, fmt);
+    len = vsnprintf(buf, CORE_TEXT_MAXLEN, fmt, args);
+    va_end(args);
+    assertf(len < CORE_TEXT_MAXLEN, "Text is longer than %d characters: %s...\n", CORE_TEXT_MAXLEN-1, buf);
+    return core_text_print(text, parms, font, x, y, buf);
+}
+
+
+/*==============================
+    core_text_free
+    Frees the layout of a cached text
+    @param  The cached text
+==============================*/
+
+void core_text_free(CoreText* text)
+{
+    if (text->layout != NULL)
+        rdpq_paragraph_free(text->layout);
+    text->layout = NULL;
+    text->text[0] = '\0';
+}
+
+
+/*==============================
+    core_text_get_layoutsbuilt
+    Gets how many text layouts were built
+    @return The number of layouts built
+==============================*/
+
+uint32_t core_text_get_layoutsbuilt()
+{
+    return global_core_text_built;
+}
+
+
+/*==============================
+    core_text_get_layoutsavoided
+    Gets how many text layouts were reused instead
+    of being built again
+    @return The number of layouts avoided
+==============================*/
+
+uint32_t core_text_get_layoutsavoided()
+{
+    return global_core_text_avoided;
+}
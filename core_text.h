@@ -0,0 +1,81 @@
+#ifndef GAMEJAM2024_CORE_TEXT_H
+#define GAMEJAM2024_CORE_TEXT_H
+
+    /***************************************************************
+                       Public Core Text Constants
+    ***************************************************************/
+
+    // The longest string a cached text can hold (including the null terminator).
+    // Printing a longer one asserts
+    #define CORE_TEXT_MAXLEN  128
+
+    // A retained piece of text. The glyph layout is kept between frames
+    // and only rebuilt when the string, font or text parameters change.
+    // Zero initialize it (globals already are) before the first use.
+    typedef struct {
+        rdpq_paragraph_t* layout;
+        rdpq_textparms_t  parms;
+        uint8_t font;
+        char    text[CORE_TEXT_MAXLEN];
+    } CoreText;
+
+
+    /***************************************************************
+                       Public Core Text Functions
+    ***************************************************************/
+
+    /*==============================
+        core_text_print
+        Draws a string, reusing the previous layout
+        of this text if nothing has changed
+        @param  The cached text
+        @param  The text parameters (can be NULL)
+        @param  The font ID
+        @param  The X position
+        @param  The Y position
+        @param  The string to draw
+        @return The metrics of the drawn text
+    ==============================*/
+    rdpq_textmetrics_t core_text_print(CoreText* text, const rdpq_textparms_t* parms, uint8_t font, float x, float y, const char* str);
+
+    /*==============================
+        core_text_printf
+        Same as core_text_print, but with a format string.
+        The string is still formatted every call, only the
+        layout is cached.
+        @param  The cached text
+        @param  The text parameters (can be NULL)
+        @param  The font ID
+        @param  The X position
+        @param  The Y position
+        @param  The format string
+        @param  The format arguments
+        @return The metrics of the drawn text
+    ==============================*/
+    rdpq_textmetrics_t core_text_printf(CoreText* text, const rdpq_textparms_t* parms, uint8_t font, float x, float y, const char* fmt, ...)
+        __attribute__((format(printf, 6, 7)));
+
+    /*==============================
+        core_text_free
+        Frees the layout of a cached text. Do this before
+        freeing the font it was drawn with.
+        @param  The cached text
+    ==============================*/
+    void core_text_free(CoreText* text);
+
+    /*==============================
+        core_text_get_layoutsbuilt
+        Gets how many text layouts were built
+        @return The number of layouts built
+    ==============================*/
+    uint32_t core_text_get_layoutsbuilt();
+
+    /*==============================
+        core_text_get_layoutsavoided
+        Gets how many text layouts were reused instead
+        of being built again
+        @return The number of layouts avoided
+    ==============================*/
+    uint32_t core_text_get_layoutsavoided();
+
+#endif
@@ -0,0 +1,51 @@
+/***************************************************************
+                          core_trace.c
+
+The file contains the trace ring buffer, which the CORE_TRACE_*
+macros write timestamped events into, and which can be dumped 
+over the debug log to be viewed on a timeline.
+***************************************************************/
+
+#include <libdragon.h>
+#include "core.h"
+
+
+/*********************************
+             Globals
+*********************************/
+
+#if CORE_TRACE
+    // The ring buffer. The head only ever grows, the events are at head modulo the size
+    CoreTraceEvent global_core_trace_events[CORE_TRACE_EVENTS];
+    uint32_t global_core_trace_head = 0;
+#endif
+
+
+/*==============================
+    core_trace_dump
+    Prints the ring buffer to the debug log and
+    empties it
+==============================*/
+
+void core_trace_dump()
+{
+    #if CORE_TRACE
+        const char types[] = {'B', 'E', 'C', 'i'};
+        uint32_t count = global_core_trace_head;
+        uint32_t first, base;
+        if (count > CORE_TRACE_EVENTS)
+            count = CORE_TRACE_EVENTS;
+        first = global_core_trace_head - count;
+        base = global_core_trace_events[first & (CORE_TRACE_EVENTS-1)].ticks;
+
+        // Times are relative to the oldest event, so the tick counter wrapping around doesn't matter
+        debugf("TRACE-BEGIN %ld events, %ld dropped\n", count, global_core_trace_head - count);
+        for (uint32_t i=first; i<global_core_trace_head; i++)
+        {
+            CoreTraceEvent* ev = &global_core_trace_events[i & (CORE_TRACE_EVENTS-1)];
+            debugf("TRACE %c %lld %ld %s\n", types[ev->type], TICKS_TO_US((uint32_t)(ev->ticks - base)), ev->value, ev->name);
+        }
+        debugf("TRACE-END\n");
+        global_core_trace_head = 0;
+    #endif
+}
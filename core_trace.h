@@ -0,0 +1,100 @@
+#ifndef GAMEJAM2024_CORE_TRACE_H
+#define GAMEJAM2024_CORE_TRACE_H
+
+    /***************************************************************
+                      Public Core Trace Constants
+    ***************************************************************/
+
+    // Tracing is only compiled in when building with "make TRACE=1".
+    // Otherwise every CORE_TRACE_* macro compiles to nothing, so they can 
+    // be left in your hot paths.
+    #ifndef CORE_TRACE
+        #define CORE_TRACE  0
+    #endif
+
+    // How many events the ring buffer keeps (must be a power of two). Once 
+    // it's full, the oldest events are overwritten.
+    #define CORE_TRACE_EVENTS  4096
+
+    typedef enum {
+        TRACE_BEGIN = 0,
+        TRACE_END,
+        TRACE_COUNTER,
+        TRACE_INSTANT,
+    } CoreTraceType;
+
+    typedef struct {
+        uint32_t ticks;
+        const char* name;
+        CoreTraceType type;
+        int32_t value;
+    } CoreTraceEvent;
+
+
+    /***************************************************************
+                      Public Core Trace Functions
+    ***************************************************************/
+
+    #if CORE_TRACE
+        extern CoreTraceEvent global_core_trace_events[CORE_TRACE_EVENTS];
+        extern uint32_t global_core_trace_head;
+
+        /*==============================
+            core_trace_event
+            Adds an event to the ring buffer. Only call this 
+            from the main thread, not from interrupts. Use 
+            the CORE_TRACE_* macros instead of calling it.
+            @param  The event type
+            @param  The name of the event (must be a string literal)
+            @param  The counter value (only for counters)
+        ==============================*/
+        static inline void core_trace_event(CoreTraceType type, const char* name, int32_t value)
+        {
+            CoreTraceEvent* ev = &global_core_trace_events[global_core_trace_head++ & (CORE_TRACE_EVENTS-1)];
+            ev->ticks = TICKS_READ();
+            ev->name = name;
+            ev->type = type;
+            ev->value = value;
+        }
+
+        static inline void core_trace_scope_end(const char** name)
+        {
+            core_trace_event(TRACE_END, *name, 0);
+        }
+
+        #define CORE_TRACE_CONCAT2(a, b)   a##b
+        #define CORE_TRACE_CONCAT(a, b)    CORE_TRACE_CONCAT2(a, b)
+
+        // Starts and ends a named span of time. The names must match and be string literals
+        #define CORE_TRACE_BEGIN(name)  core_trace_event(TRACE_BEGIN, name, 0)
+        #define CORE_TRACE_END(name)    core_trace_event(TRACE_END, name, 0)
+
+        // A span that ends when the enclosing block does
+        #define CORE_TRACE_SCOPE(name) \
+            const char* CORE_TRACE_CONCAT(core_trace_scope_, __LINE__) __attribute__((cleanup(core_trace_scope_end))) = \
+                (core_trace_event(TRACE_BEGIN, name, 0), name)
+
+        // A value that is plotted over time, like the number of live objects
+        #define CORE_TRACE_COUNTER(name, value)  core_trace_event(TRACE_COUNTER, name, (int32_t)(value))
+
+        // A single point in time, like a collision
+        #define CORE_TRACE_INSTANT(name)  core_trace_event(TRACE_INSTANT, name, 0)
+    #else
+        #define CORE_TRACE_BEGIN(name)           ((void)0)
+        #define CORE_TRACE_END(name)             ((void)0)
+        #define CORE_TRACE_SCOPE(name)           ((void)0)
+        #define CORE_TRACE_COUNTER(name, value)  ((void)0)
+        #define CORE_TRACE_INSTANT(name)         ((void)0)
+    #endif
+
+    /*==============================
+        core_trace_dump
+        Prints the ring buffer to the debug log, oldest
+        events first, and empties it. Convert the log with
+        tools/trace2json.sh and open it in a trace viewer
+        (chrome://tracing or ui.perfetto.dev). Does nothing
+        if tracing isn't compiled in.
+    ==============================*/
+    void core_trace_dump();
+
+#endif
@@ -0,0 +1,121 @@
+/***************************************************************
+                          core_tween.c
+
+The file contains the tween engine, which animates fixed point
+values over a number of ticks with an easing curve.
+***************************************************************/
+
+#include <libdragon.h>
+#include "core.h"
+
+
+/*********************************
+             Globals
+*********************************/
+
+// The tween clock, in 16.16 fixed point ticks
+static uint32_t global_core_tween_clock = 0;
+
+
+/*==============================
+    core_tween_update
+    Advances the tween clock. Called once per frame
+    @param  The time since the last frame, in seconds
+==============================*/
+
+void core_tween_update(float deltatime)
+{
+    global_core_tween_clock += (uint32_t)(deltatime*(TICKRATE*CORE_TWEEN_ONE));
+}
+
+
+/*==============================
+    core_tween_start
+    Starts animating a value
+    @param  The tween
+    @param  The starting value, in fixed point
+    @param  The final value, in fixed point
+    @param  How long the animation takes, in ticks
+    @param  The easing curve
+==============================*/
+
+void core_tween_start(CoreTween* tween, int32_t from, int32_t to, uint32_t ticks, CoreEase ease)
+{
+    tween->from = from;
+    tween->to = to;
+    tween->start = global_core_tween_clock;
+    tween->duration = ticks*CORE_TWEEN_ONE;
+    tween->ease = ease;
+}
+
+
+/*==============================
+    core_tween_retarget
+    Starts animating a value towards a new target
+    @param  The tween
+    @param  The final value, in fixed point
+    @param  How long the animation takes, in ticks
+    @param  The easing curve
+==============================*/
+
+void core_tween_retarget(CoreTween* tween, int32_t to, uint32_t ticks, CoreEase ease)
+{
+    if (tween->to == to)
+        return;
+    core_tween_start(tween, core_tween_value(tween), to, ticks, ease);
+}
+
+
+/*==============================
+    core_tween_value
+    Gets the current value of a tween
+    @param  The tween
+    @return The value, in fixed point
+==============================*/
+
+int32_t core_tween_value(const CoreTween* tween)
+{
+    uint32_t elapsed = global_core_tween_clock - tween->start;
+    int32_t t, e, inv;
+    if (elapsed >= tween->duration)
+        return tween->to;
+
+    // Progress and eased progress, both from 0 to CORE_TWEEN_ONE
+    t = ((uint64_t)elapsed << 16)/tween->duration;
+    inv = CORE_TWEEN_ONE - t;
+    switch (tween->ease)
+    {
+        case EASE_IN_QUAD:
+            e = ((int64_t)t*t) >> 16;
+            break;
+        case EASE_OUT_QUAD:
+            e = CORE_TWEEN_ONE - (((int64_t)inv*inv) >> 16);
+            break;
+        case EASE_INOUT_QUAD:
+            if (t < CORE_TWEEN_ONE/2)
+                e = ((int64_t)t*t) >> 15;
+            else
+                e = CORE_TWEEN_ONE - (((int64_t)inv*inv) >> 15);
+            break;
+        case EASE_OUT_CUBIC:
+            e = CORE_TWEEN_ONE - (((((int64_t)inv*inv) >> 16)*inv) >> 16);
+            break;
+        default:
+            e = t;
+            break;
+    }
+    return tween->from + (int32_t)((((int64_t)tween->to - tween->from)*e) >> 16);
+}
+
+
+/*==============================
+    core_tween_finished
+    Checks whether a tween reached its final value
+    @param  The tween
+    @return Whether the tween is finished
+==============================*/
+
+bool core_tween_finished(const CoreTween* tween)
+{
+    return global_core_tween_clock - tween->start >= tween->duration;
+}
@@ -0,0 +1,86 @@
+#ifndef GAMEJAM2024_CORE_TWEEN_H
+#define GAMEJAM2024_CORE_TWEEN_H
+
+    /***************************************************************
+                      Public Core Tween Constants
+    ***************************************************************/
+
+    // Tween values are 16.16 fixed point numbers
+    #define CORE_TWEEN_ONE      (1 << 16)
+    #define CORE_TWEEN_FIX(x)   ((int32_t)((x)*CORE_TWEEN_ONE))
+    #define CORE_TWEEN_INT(x)   ((int)(((x) + (CORE_TWEEN_ONE/2)) >> 16))
+
+    // Easing curves
+    typedef enum {
+        EASE_LINEAR = 0,
+        EASE_IN_QUAD,
+        EASE_OUT_QUAD,
+        EASE_INOUT_QUAD,
+        EASE_OUT_CUBIC,
+    } CoreEase;
+
+    // An animated value. Durations are in ticks (TICKRATE per second,
+    // whatever the minigame's .tickrate is), and the tween clock 
+    // advances with real time, so the animation takes the same time
+    // regardless of the frame rate.
+    typedef struct {
+        int32_t  from;
+        int32_t  to;
+        uint32_t start;
+        uint32_t duration;
+        CoreEase ease;
+    } CoreTween;
+
+
+    /***************************************************************
+                      Public Core Tween Functions
+    ***************************************************************/
+
+    /*==============================
+        core_tween_start
+        Starts animating a value
+        @param  The tween
+        @param  The starting value, in fixed point
+        @param  The final value, in fixed point
+        @param  How long the animation takes, in ticks
+        @param  The easing curve
+    ==============================*/
+    void core_tween_start(CoreTween* tween, int32_t from, int32_t to, uint32_t ticks, CoreEase ease);
+
+    /*==============================
+        core_tween_retarget
+        Starts animating a value towards a new target,
+        from wherever it currently is. Does nothing if
+        it's already heading there.
+        @param  The tween
+        @param  The final value, in fixed point
+        @param  How long the animation takes, in ticks
+        @param  The easing curve
+    ==============================*/
+    void core_tween_retarget(CoreTween* tween, int32_t to, uint32_t ticks, CoreEase ease);
+
+    /*==============================
+        core_tween_value
+        Gets the current value of a tween
+        @param  The tween
+        @return The value, in fixed point
+    ==============================*/
+    int32_t core_tween_value(const CoreTween* tween);
+
+    /*==============================
+        core_tween_finished
+        Checks whether a tween reached its final value
+        @param  The tween
+        @return Whether the tween is finished
+    ==============================*/
+    bool core_tween_finished(const CoreTween* tween);
+
+    
+    /***************************************************************
+                     Internal Core Tween Functions
+                  Do not use anything below this line
+    ***************************************************************/
+
+    void core_tween_update(float deltatime);
+
+#endif
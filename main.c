@@ -14,6 +14,22 @@ and provides a basic game loop.
 #include "minigame.h"
 
 
+/*********************************
+             Globals
+*********************************/
+
+// Released assets that stay resident between minigames. The menu comes back after
+// every game, so its art (about 36KB) is kept instead of being loaded again each time.
+// The round sounds don't need to be listed, as the core holds them for the whole run
+static const char* global_core_residentassets[] = {
+    "rom:/squarewave.font64",
+    "rom:/n64brew.ia8.sprite",
+    "rom:/jam.rgba32.sprite",
+    CORE_ATLAS_ICONS,
+    NULL,
+};
+
+
 /*==============================
     main
     The program main
@@ -21,30 +37,52 @@ and provides a basic game loop.
 
 int main()
 {
-    #if DEBUG
-    	debug_init_isviewer();
-    	debug_init_usblog();
-    #endif
+    core_boot_step("Power on to main");
+
+    // Bring up the debug log first, so every step after it can print
+    debug_init_usblog();
+    debug_init_isviewer();
+    core_boot_step("Debug log");
     
     // Initialize most subsystems
     asset_init_compression(2);
     asset_init_compression(3);
+    core_boot_step("Compression");
     dfs_init(DFS_DEFAULT_LOCATION);
-    debug_init_usblog();
-    debug_init_isviewer();
+    core_boot_step("DFS");
     joypad_init();
+    core_boot_step("Joypad");
     timer_init();
+    core_boot_step("Timer");
     rdpq_init();
+    core_boot_step("RDPQ");
     minigame_loadall();
-    audio_init(32000, 3);
-    mixer_init(32);
+    core_boot_step("Minigame list");
+    #if BOOT_DEFER_AUDIO
+        core_boot_defer("Audio and mixer", core_audio_init);
+    #else
+        core_audio_init();
+        core_boot_step("Audio and mixer");
+    #endif
+    core_round_init();
+    core_boot_step("Round sounds");
+
+    #if ASSET_BENCHMARK
+        core_asset_benchmark();
+        core_boot_step("Asset benchmark");
+    #endif
 
     // Enable RDP debugging
-    #if DEBUG_RDP
+    #if DEBUG_RDP || RDP_STATS
         rdpq_debug_start();
+    #endif
+    #if DEBUG_RDP
         rdpq_debug_log(true);
         rspq_profile_start();
     #endif
+    #if RDP_STATS
+        core_rdpstats_init();
+    #endif
 
     // Initialize the random number generator
     uint32_t seed;
@@ -56,51 +94,86 @@ int main()
     {
         char* game;
         float accumulator = 0;
-        const float dt = DELTATIME;
+        float dt;
 
         // Show the menu
         game = menu();
+        core_boot_finish();
+
+        // Free what the last minigame released, but keep the menu's assets
+        core_asset_flush(global_core_residentassets);
         
         // Set the initial minigame
+        uint32_t transitionstart = TICKS_READ();
         minigame_play(game);
 
         // Initialize the minigame
         core_reset_winners();
+        core_display_set(&minigame_get_game()->definition.display);
+        core_systems_set(minigame_get_game()->definition.systems, minigame_get_game()->definition.audiofrequency, minigame_get_game()->definition.mixerchannels);
+        core_audio_set_budget(minigame_get_game()->definition.sfxvoices);
+        core_set_tickrate(minigame_get_game()->definition.tickrate);
+        dt = 1.0f/core_get_tickrate();
         minigame_get_game()->funcPointer_init();
+        debugf("Minigame started in %lld us\n", TICKS_TO_US(TICKS_SINCE(transitionstart)));
         
+        // Don't count the audio that ran dry during the menu and loading
+        core_audio_pump();
+        core_audio_resetstats();
+        core_rdpstats_reset();
+
         // Handle the engine loop
         while (!minigame_get_ended())
         {
             float frametime = display_get_delta_time();
+            CORE_TRACE_INSTANT("Frame");
+            core_tween_update(frametime);
             
             // In order to prevent problems if the game slows down significantly, we will clamp the maximum timestep the simulation can take
             if (frametime > 0.25f)
                 frametime = 0.25f;
             
-            // Perform the update in discrete steps (ticks)
-            if (minigame_get_game()->funcPointer_fixedloop) {
+            // Perform the update in discrete steps (ticks). Time doesn't pass while paused
+            if (!core_input_is_paused())
                 accumulator += frametime;
-                while (accumulator >= dt)
-                {
+            while (accumulator >= dt)
+            {
+                CORE_TRACE_BEGIN("Tick");
+                core_next_tick();
+                core_round_tick();
+                if (minigame_get_game()->funcPointer_fixedloop)
                     minigame_get_game()->funcPointer_fixedloop(dt);
-                    accumulator -= dt;
-                }
+                CORE_TRACE_END("Tick");
+                core_audio_pump();
+                accumulator -= dt;
             }
 
             // Read controler data
             joypad_poll();
-            mixer_try_play();
+            core_input_update();
+            core_audio_pump();
             
             // Perform the unfixed loop
             core_set_subtick(((double)accumulator)/((double)dt));
+            CORE_TRACE_BEGIN("Loop");
             minigame_get_game()->funcPointer_loop(frametime);
+            CORE_TRACE_END("Loop");
+            core_rdpstats_frame_end();
+            core_audio_pump();
         }
         
         // End the current level
+        uint32_t cleanupstart = TICKS_READ();
         rspq_wait();
-        for (int i=0; i<32; i++)
-            mixer_ch_stop(i);
+        core_audio_stopall();
         minigame_get_game()->funcPointer_cleanup();
+        core_round_stop();
+        core_rdpstats_report(minigame_get_game()->internalname);
+        core_trace_dump(); // Before the minigame is unloaded, as its event names are in its DSO
         minigame_cleanup();
+        debugf("Minigame cleaned up in %lld us\n", TICKS_TO_US(TICKS_SINCE(cleanupstart)));
+        debugf("Text layouts: %ld built, %ld avoided\n", core_text_get_layoutsbuilt(), core_text_get_layoutsavoided());
+        core_audio_report();
+        debugf("Asset cache: %ld hits, %ld misses, %ld bytes resident\n", core_asset_get_hits(), core_asset_get_misses(), core_asset_get_residentbytes());
     }
 }
\ No newline at end of file
@@ -6,6 +6,7 @@ This file contains the code for the basic menu
 
 #include <libdragon.h>
 #include <string.h>
+#include <ctype.h>
 #include "menu.h"
 #include "core.h"
 #include "config.h"
@@ -18,6 +19,17 @@ This file contains the code for the basic menu
 #define FONT_TEXT       1
 #define FONT_DEBUG      2
 
+#define MENU_X          80
+#define MENU_ROWS       5   // How many minigames are shown per page
+#define HIGHLIGHT_TICKS 5   // How long the highlight takes to reach the selection
+
+#define SCROLL_DELAY    12  // Frames a direction must be held before it repeats
+#define SCROLL_SLOWEST  6   // Frames between the first repeats
+#define SCROLL_SPEEDUP  4   // Repeats before the next one comes a frame sooner
+
+#define LETTER_OTHER    26  // Names that don't start with a letter
+#define LETTER_COUNT    27
+
 typedef enum
 {
     SCREEN_PLAYERCOUNT,
@@ -25,6 +37,13 @@ typedef enum
     SCREEN_MINIGAME
 } menu_screen;
 
+typedef enum
+{
+    FILTER_NONE,
+    FILTER_LETTER,
+    FILTER_DEVELOPER
+} menu_filter;
+
 /*==============================
     minigame_sort
     Sorts two names alphabetically
@@ -39,6 +58,36 @@ static int minigame_sort(const void *a, const void *b)
     return strcasecmp(global_minigame_list[idx1].definition.gamename, global_minigame_list[idx2].definition.gamename);
 }
 
+/*==============================
+    developer_sort
+    Sorts two minigames by developer name, then by name
+    @param  The first minigame index
+    @param  The second minigame index
+    @return -1 if a is less than b, 1 if a is greater than b, and 0 if they are equal
+==============================*/
+
+static int developer_sort(const void *a, const void *b)
+{
+    int idx1 = *(int*)a, idx2 = *(int*)b;
+    int cmp = strcasecmp(global_minigame_list[idx1].definition.developername, global_minigame_list[idx2].definition.developername);
+    if (cmp != 0) return cmp;
+    return minigame_sort(a, b);
+}
+
+/*==============================
+    get_letter
+    Gets the initial letter group of a name
+    @param  The name
+    @return The letter (0 to 25), or LETTER_OTHER
+==============================*/
+
+static int get_letter(const char *name)
+{
+    int c = toupper((unsigned char)name[0]);
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    return LETTER_OTHER;
+}
+
 /*==============================
     get_selection_offset
     Converts a joypad 8-way direction into a vertical selection offset
@@ -94,6 +143,124 @@ static int item_count;              // The number of selection items in the curr
 static const char *heading;         // The heading of the menu screen
 static int select;                  // The currently selected item
 
+static int yselect_target;          // Where the highlight should be
+static CoreTween yselect;           // Where the highlight is
+static int scroll_top;              // The first visible item
+
+// Minigame index, built once
+static int *index_byname;           // All minigames, sorted by name
+static int *index_letter;           // The initial letter of each minigame
+static int *index_developer;        // The developer group of each minigame
+static const char **developer_names;// The name of each developer group
+static int developer_count;
+
+// The minigames shown with the current filter
+static menu_filter filter_mode = FILTER_NONE;
+static int filter_value;
+static int *view_indices;
+static int view_count;
+
+// Button hints shown next to the minigame list
+static CoreAtlas *icons;
+static const struct {
+    const char *icon[2];
+    const char *label;
+} hints[] = {
+    {{"LTrigger", "RTrigger"}, "Page"},
+    {{"CLeft", "CRight"}, "Letter"},
+    {{"ZTrigger", NULL}, "Dev"},
+    {{"BButton", NULL}, "Back"},
+};
+
+/*==============================
+    build_index
+    Sorts the minigames and groups them by initial
+    letter and developer, so that filtering doesn't
+    need to compare strings
+==============================*/
+
+static void build_index()
+{
+    int *bydeveloper;
+    if (index_byname != NULL) return;
+
+    index_byname = malloc(sizeof(int)*global_minigame_count);
+    index_letter = malloc(sizeof(int)*global_minigame_count);
+    index_developer = malloc(sizeof(int)*global_minigame_count);
+    developer_names = malloc(sizeof(char*)*global_minigame_count);
+    view_indices = malloc(sizeof(int)*global_minigame_count);
+    bydeveloper = malloc(sizeof(int)*global_minigame_count);
+
+    for (int i = 0; i < global_minigame_count; i++) {
+        index_byname[i] = i;
+        bydeveloper[i] = i;
+        index_letter[i] = get_letter(global_minigame_list[i].definition.gamename);
+    }
+    qsort(index_byname, global_minigame_count, sizeof(int), minigame_sort);
+    qsort(bydeveloper, global_minigame_count, sizeof(int), developer_sort);
+
+    // Number the developers in alphabetical order
+    developer_count = 0;
+    for (int i = 0; i < global_minigame_count; i++) {
+        const char *dev = global_minigame_list[bydeveloper[i]].definition.developername;
+        if (developer_count == 0 || strcasecmp(developer_names[developer_count-1], dev))
+            developer_names[developer_count++] = dev;
+        index_developer[bydeveloper[i]] = developer_count-1;
+    }
+    free(bydeveloper);
+}
+
+/*==============================
+    build_view
+    Builds the list of minigames that pass the 
+    current filter
+    @return The number of minigames in the list
+==============================*/
+
+static int build_view()
+{
+    view_count = 0;
+    for (int i = 0; i < global_minigame_count; i++) {
+        int game = index_byname[i];
+        if (filter_mode == FILTER_LETTER && index_letter[game] != filter_value) continue;
+        if (filter_mode == FILTER_DEVELOPER && index_developer[game] != filter_value) continue;
+        view_indices[view_count++] = game;
+    }
+    return view_count;
+}
+
+/*==============================
+    cycle_filter
+    Moves to the next (or previous) letter or developer
+    which has minigames
+    @param  The filter to cycle
+    @param  1 for the next value, -1 for the previous one
+==============================*/
+
+static void cycle_filter(menu_filter mode, int direction)
+{
+    int count = (mode == FILTER_LETTER) ? LETTER_COUNT : developer_count;
+    if (filter_mode != mode) {
+        filter_mode = mode;
+        filter_value = (direction > 0) ? -1 : count;
+    }
+    for (int tries = 0; tries < count; tries++) {
+        filter_value = (filter_value + direction + count) % count;
+        if (build_view() > 0) break;
+    }
+}
+
+/*==============================
+    clear_filter
+    Shows all the minigames again
+==============================*/
+
+static void clear_filter()
+{
+    filter_mode = FILTER_NONE;
+    build_view();
+}
+
 /*==============================
     set_menu_screen
     Switches the menu to another screen
@@ -120,11 +287,130 @@ void set_menu_screen(menu_screen screen)
         heading = "AI difficulty?\n";
         break;
     case SCREEN_MINIGAME:
-        item_count = global_minigame_count;
+        item_count = view_count;
         select = 0;
         heading = "Pick a game!\n";
         break;
     }
+    scroll_top = 0;
+}
+
+/*==============================
+    menu_record_background
+    Records the parts of the menu that never change
+    @param  The color to clear the screen with
+    @param  The N64brew logo
+    @param  The jam logo
+    @return The recorded block
+==============================*/
+
+static rspq_block_t* menu_record_background(color_t clearcolor, sprite_t* logo, sprite_t* jam)
+{
+    const color_t BLACK = RGBA32(0x00,0x00,0x00,0xFF);
+    const color_t BREWFONT = RGBA32(242,209,155,0xFF);
+
+    rspq_block_begin();
+    rdpq_clear(clearcolor);
+
+    rdpq_set_mode_standard();
+    rdpq_mode_blender(RDPQ_BLENDER_MULTIPLY);
+    rdpq_mode_combiner(RDPQ_COMBINER1((PRIM,ENV,TEX0,ENV), (0,0,0,TEX0)));
+    rdpq_set_prim_color(BREWFONT);  // fill color
+    rdpq_set_env_color(BLACK);      // outline color
+    rdpq_sprite_blit(logo, 35, 20, NULL);
+
+    rdpq_set_mode_standard();
+    rdpq_mode_blender(RDPQ_BLENDER_MULTIPLY);
+    rdpq_sprite_blit(jam, 35+190, 10, NULL);
+    return rspq_block_end();
+}
+
+/*==============================
+    menu_layout
+    Lays out and records the text of the current screen,
+    and finds where the highlight should go. Only the
+    visible minigames are laid out.
+    @param  The Y position of the heading
+    @param  The amount of memory used, in bytes
+    @return The recorded block
+==============================*/
+
+static rspq_block_t* menu_layout(int y0, int memused)
+{
+    rdpq_textparms_t textparms = {
+        .width = 200, .tabstops = (int16_t[]){ 15 },
+    };
+
+    rspq_block_begin();
+    rdpq_set_mode_standard();
+
+    int ycur = y0;
+    int first = 0, last = item_count;
+    if (current_screen == SCREEN_MINIGAME) {
+        if (filter_mode == FILTER_LETTER && filter_value == LETTER_OTHER)
+            ycur += rdpq_text_print(&textparms, FONT_TEXT, MENU_X-20, ycur, "Pick a game! (#)\n").advance_y;
+        else if (filter_mode == FILTER_LETTER)
+            ycur += rdpq_text_printf(&textparms, FONT_TEXT, MENU_X-20, ycur, "Pick a game! (%c)\n", 'A' + filter_value).advance_y;
+        else if (filter_mode == FILTER_DEVELOPER)
+            ycur += rdpq_text_printf(&textparms, FONT_TEXT, MENU_X-20, ycur, "By %s:\n", developer_names[filter_value]).advance_y;
+        else
+            ycur += rdpq_text_print(&textparms, FONT_TEXT, MENU_X-20, ycur, heading).advance_y;
+
+        first = scroll_top;
+        last = scroll_top + MENU_ROWS;
+        if (last > item_count) last = item_count;
+        if (item_count > MENU_ROWS) {
+            rdpq_text_printf(NULL, FONT_DEBUG, MENU_X+160, y0, "%d/%d",
+                scroll_top/MENU_ROWS + 1, (item_count + MENU_ROWS - 1)/MENU_ROWS);
+        }
+
+        // All the icons first, so each atlas page is only uploaded once
+        core_atlas_begin(icons);
+        for (int i = 0; i < (int)(sizeof(hints)/sizeof(hints[0])); i++)
+            for (int j = 0; j < 2 && hints[i].icon[j] != NULL; j++)
+                core_atlas_draw(icons, core_atlas_find(icons, hints[i].icon[j]), MENU_X+160 + j*18, y0 + 6 + i*18);
+        rdpq_set_mode_standard();
+        for (int i = 0; i < (int)(sizeof(hints)/sizeof(hints[0])); i++)
+            rdpq_text_print(NULL, FONT_DEBUG, MENU_X+196, y0 + 18 + i*18, hints[i].label);
+    } else {
+        ycur += rdpq_text_print(&textparms, FONT_TEXT, MENU_X-20, ycur, heading).advance_y;
+    }
+    ycur += 4;
+
+    for (int i = first; i < last; i++) {
+        if (select == i) yselect_target = ycur;
+
+        switch (current_screen) {
+        case SCREEN_PLAYERCOUNT:
+            ycur += rdpq_text_printf(&textparms, FONT_TEXT, MENU_X, ycur, "%d\n", i+1).advance_y;
+            break;
+        case SCREEN_AIDIFFICULTY:
+            ycur += rdpq_text_printf(&textparms, FONT_TEXT, MENU_X, ycur, "%s\n", get_difficulty_name(i)).advance_y;
+            break;
+        case SCREEN_MINIGAME:
+            ycur += rdpq_text_printf(&textparms, FONT_TEXT, MENU_X, ycur, "%d.\t%s\n", i+1, global_minigame_list[view_indices[i]].definition.gamename).advance_y;
+            break;
+        }
+    }
+
+    if (current_screen == SCREEN_MINIGAME) {
+        // Show the description of the selected minigame
+        rdpq_textparms_t parms = {
+            .width = 300, .wrap = WRAP_WORD,
+        };
+
+        Minigame *cur = &global_minigame_list[view_indices[select]];
+
+        int y0 = 180;
+        y0 += rdpq_text_printf(&parms, FONT_TEXT, 10, y0, "%s\n\n", cur->definition.description).advance_y;
+        y0 += rdpq_text_printf(&parms, FONT_TEXT, 10, y0, "%s\n", cur->definition.instructions).advance_y;
+    }
+
+    if (true) {
+        rdpq_text_printf(NULL, FONT_DEBUG, 10, 15, 
+            "Mem: %d KiB", memused/1024);
+    }
+    return rspq_block_end();
 }
 
 /*==============================
@@ -135,22 +421,21 @@ void set_menu_screen(menu_screen screen)
 
 char* menu(void)
 {
-    const color_t BLACK = RGBA32(0x00,0x00,0x00,0xFF);
     const color_t ASH_GRAY = RGBA32(0xAD,0xBA,0xBD,0xFF);
     const color_t MAYA_BLUE = RGBA32(0x6C,0xBE,0xED,0xFF);
     const color_t GUN_METAL = RGBA32(0x31,0x39,0x3C,0xFF);
     const color_t REDWOOD = RGBA32(0xB2,0x3A,0x7A,0xFF);
-    const color_t BREWFONT = RGBA32(242,209,155,0xFF);
 
     heap_stats_t heap_stats;
     sys_get_heap_stats(&heap_stats);
 
-    display_init(RESOLUTION_320x240, DEPTH_16_BPP, 3, GAMMA_NONE, FILTERS_RESAMPLE);
+    core_display_set(NULL);
 
-    sprite_t *logo = sprite_load("rom:/n64brew.ia8.sprite");
-    sprite_t *jam = sprite_load("rom:/jam.rgba32.sprite");
+    sprite_t *logo = core_asset_sprite("rom:/n64brew.ia8.sprite");
+    sprite_t *jam = core_asset_sprite("rom:/jam.rgba32.sprite");
+    icons = core_asset_atlas(CORE_ATLAS_ICONS);
     
-    rdpq_font_t *font = rdpq_font_load("rom:/squarewave.font64");
+    rdpq_font_t *font = core_asset_font("rom:/squarewave.font64");
     rdpq_text_register_font(FONT_TEXT, font);
     rdpq_font_style(font, 0, &(rdpq_fontstyle_t){.color = MAYA_BLUE, .outline_color = GUN_METAL });
 
@@ -162,20 +447,35 @@ char* menu(void)
         if (joypad_is_connected(i)) max_playercount++;
     }
 
-    bool has_moved_selection = false;
+    int held_frames = 0;
+    int held_repeats = 0;
     bool menu_done = false;
 
-    float yselect = -1;
-    float yselect_target = -1;
-
-    int sorted_indices[global_minigame_count];
-    for (int i = 0; i < global_minigame_count; i++) sorted_indices[i] = i;
-    qsort(sorted_indices, global_minigame_count, sizeof(int), minigame_sort);
+    bool highlight_placed = false;
+    yselect_target = -1;
+
+    // The logos never change, and the text only changes when the selection or the screen do
+    rspq_block_t* background_layer = menu_record_background(ASH_GRAY, logo, jam);
+    rspq_block_t* text_layer = NULL;
+    menu_screen layout_screen = current_screen;
+    int layout_select = -1;
+    int layout_top = -1;
+    int layout_count_items = -1;
+    menu_filter layout_filter = FILTER_NONE;
+    int layout_filtervalue = -1;
+    uint32_t layout_count = 0;
+    uint32_t layout_uploads = 0;
+    uint32_t icon_uploads = 0;
+    uint32_t frame_count = 0;
+    uint64_t frame_ticks = 0;
+
+    build_index();
+    build_view();
 
     int selected_minigame = -1;
     if (SKIP_MINIGAMESELECTION) {
         for (int i = 0; i < global_minigame_count; i++) {
-            if (!strcasecmp(global_minigame_list[sorted_indices[i]].internalname, MINIGAME_TO_TEST)) {
+            if (!strcasecmp(global_minigame_list[i].internalname, MINIGAME_TO_TEST)) {
                 selected_minigame = i;
                 break;
             }
@@ -197,18 +497,42 @@ char* menu(void)
     while (!menu_done) {
         joypad_poll();
 
+        // Move the selection, repeating faster and faster while the direction is held
         int selection_offset = get_selection_offset(joypad_get_direction(JOYPAD_PORT_1, JOYPAD_2D_ANY));
         if (selection_offset != 0) {
-            if (!has_moved_selection) select += selection_offset;
-            has_moved_selection = true;
+            int interval = SCROLL_SLOWEST - held_repeats/SCROLL_SPEEDUP;
+            if (interval < 1) interval = 1;
+            if (held_frames == 0) {
+                select += selection_offset;
+            } else if (held_frames >= SCROLL_DELAY && (held_frames - SCROLL_DELAY) % interval == 0) {
+                select += selection_offset;
+                held_repeats++;
+            }
+            held_frames++;
         } else {
-            has_moved_selection = false;
+            held_frames = 0;
+            held_repeats = 0;
+        }
+
+        joypad_buttons_t btn = joypad_get_buttons_pressed(JOYPAD_PORT_1);
+
+        // Page through and filter the minigame list
+        if (current_screen == SCREEN_MINIGAME) {
+            if (btn.l) select -= MENU_ROWS;
+            if (btn.r) select += MENU_ROWS;
+            if (btn.c_right || btn.c_left || btn.z || btn.c_down || btn.c_up) {
+                if (btn.c_right) cycle_filter(FILTER_LETTER, 1);
+                if (btn.c_left) cycle_filter(FILTER_LETTER, -1);
+                if (btn.z || btn.c_down) cycle_filter(FILTER_DEVELOPER, 1);
+                if (btn.c_up) cycle_filter(FILTER_DEVELOPER, -1);
+                set_menu_screen(SCREEN_MINIGAME);
+            }
         }
 
         if (select < 0) select = 0;
         if (select > item_count-1) select = item_count-1;
-
-        joypad_buttons_t btn = joypad_get_buttons_pressed(JOYPAD_PORT_1);
+        if (current_screen == SCREEN_MINIGAME)
+            scroll_top = (select/MENU_ROWS)*MENU_ROWS;
 
         if (btn.a) {
             switch (current_screen) {
@@ -229,7 +553,7 @@ char* menu(void)
                         set_menu_screen(SCREEN_MINIGAME);
                     break;
                 case SCREEN_MINIGAME:
-                    selected_minigame = select;
+                    selected_minigame = view_indices[select];
                     menu_done = true;
                     break;
             }
@@ -239,7 +563,10 @@ char* menu(void)
                     set_menu_screen(SCREEN_PLAYERCOUNT);
                     break;
                 case SCREEN_MINIGAME:
-                    if (playercount == MAXPLAYERS) {
+                    if (filter_mode != FILTER_NONE) {
+                        clear_filter();
+                        set_menu_screen(SCREEN_MINIGAME);
+                    } else if (playercount == MAXPLAYERS) {
                         set_menu_screen(SCREEN_PLAYERCOUNT);
                     } else {
                         set_menu_screen(SCREEN_AIDIFFICULTY);
@@ -250,94 +577,83 @@ char* menu(void)
             }
         }
 
-        surface_t *disp = display_get();
-
-        rdpq_attach(disp, NULL);
-        rdpq_clear(ASH_GRAY);
-
-        rdpq_textparms_t textparms = {
-            .width = 200, .tabstops = (int16_t[]){ 15 },
-        };
+        // Time the frame's CPU work, including the layout but not the wait for a framebuffer
+        uint32_t framestart = TICKS_READ();
 
-        rdpq_set_mode_standard();
-        rdpq_mode_blender(RDPQ_BLENDER_MULTIPLY);
-        rdpq_mode_combiner(RDPQ_COMBINER1((PRIM,ENV,TEX0,ENV), (0,0,0,TEX0)));
-        rdpq_set_prim_color(BREWFONT);  // fill color
-        rdpq_set_env_color(BLACK);      // outline color
-        rdpq_sprite_blit(logo, 35, 20, NULL);
+        // Lay out the text again only if something changed
+        if (text_layer == NULL || select != layout_select || current_screen != layout_screen || scroll_top != layout_top ||
+            item_count != layout_count_items || filter_mode != layout_filter || filter_value != layout_filtervalue) {
+            if (text_layer != NULL) {
+                rspq_wait();
+                rspq_block_free(text_layer);
+            }
+            // The icon uploads are recorded in the block, so count them every time it runs
+            layout_uploads = core_atlas_get_uploads();
+            text_layer = menu_layout(20 + logo->height + 20, heap_stats.used);
+            layout_uploads = core_atlas_get_uploads() - layout_uploads;
+            layout_select = select;
+            layout_screen = current_screen;
+            layout_top = scroll_top;
+            layout_count_items = item_count;
+            layout_filter = filter_mode;
+            layout_filtervalue = filter_value;
+            layout_count++;
+        }
 
-        rdpq_set_mode_standard();
-        rdpq_mode_blender(RDPQ_BLENDER_MULTIPLY);
-        rdpq_sprite_blit(jam, 35+190, 10, NULL);
+        uint32_t waitstart = TICKS_READ();
+        surface_t *disp = display_get();
+        framestart += TICKS_SINCE(waitstart);
 
-        int x0 = 80;
-        int y0 = 20 + logo->height + 20;
+        rdpq_attach(disp, NULL);
+        rspq_block_run(background_layer);
 
+        // The highlight is the only thing that moves
+        core_tween_update(display_get_delta_time());
         if (yselect_target >= 0) {
-            if (yselect < 0) yselect = yselect_target;
-            yselect = yselect * 0.7 + yselect_target * 0.3;
+            int ysel;
+            if (!highlight_placed)
+                core_tween_start(&yselect, CORE_TWEEN_FIX(yselect_target), CORE_TWEEN_FIX(yselect_target), 0, EASE_LINEAR);
+            else
+                core_tween_retarget(&yselect, CORE_TWEEN_FIX(yselect_target), HIGHLIGHT_TICKS, EASE_OUT_CUBIC);
+            highlight_placed = true;
+            ysel = CORE_TWEEN_INT(core_tween_value(&yselect));
             rdpq_set_mode_standard();
             rdpq_mode_combiner(RDPQ_COMBINER_FLAT);
             rdpq_set_prim_color(REDWOOD);
-            rdpq_fill_rectangle(x0-10, yselect-12, x0+150, yselect+5);
-        }
-
-        rdpq_set_mode_standard();
-
-        int ycur = y0;
-        ycur += rdpq_text_print(&textparms, FONT_TEXT, x0-20, ycur, heading).advance_y;
-        ycur += 4;
-
-        for (int i = 0; i < item_count; i++) {
-            if (select == i) yselect_target = ycur;
-
-            switch (current_screen) {
-            case SCREEN_PLAYERCOUNT:
-                ycur += rdpq_text_printf(&textparms, FONT_TEXT, x0, ycur, "%d\n", i+1).advance_y;
-                break;
-            case SCREEN_AIDIFFICULTY:
-                ycur += rdpq_text_printf(&textparms, FONT_TEXT, x0, ycur, "%s\n", get_difficulty_name(i)).advance_y;
-                break;
-            case SCREEN_MINIGAME:
-                ycur += rdpq_text_printf(&textparms, FONT_TEXT, x0, ycur, "%d.\t%s\n", i+1, global_minigame_list[sorted_indices[i]].definition.gamename).advance_y;
-                break;
-            }
+            rdpq_fill_rectangle(MENU_X-10, ysel-12, MENU_X+150, ysel+5);
         }
 
-        if (current_screen == SCREEN_MINIGAME) {
-            // Show the description of the selected minigame
-            rdpq_textparms_t parms = {
-                .width = 300, .wrap = WRAP_WORD,
-            };
-
-            Minigame *cur = &global_minigame_list[sorted_indices[select]];
-
-            int y0 = 180;
-            y0 += rdpq_text_printf(&parms, FONT_TEXT, 10, y0, "%s\n\n", cur->definition.description).advance_y;
-            y0 += rdpq_text_printf(&parms, FONT_TEXT, 10, y0, "%s\n", cur->definition.instructions).advance_y;
-        }
-
-        if (true) {
-            rdpq_text_printf(NULL, FONT_DEBUG, 10, 15, 
-                "Mem: %d KiB", heap_stats.used/1024);
-        }
+        rspq_block_run(text_layer);
+        icon_uploads += layout_uploads;
         rdpq_detach_show();
+        frame_ticks += TICKS_SINCE(framestart);
+
+        // Finish booting while the menu is already on screen
+        if (frame_count == 0)
+            core_boot_step("First menu frame");
+        core_boot_run_deferred();
+        frame_count++;
     }
 
     is_first_time = false;
 
     rspq_wait();
-    sprite_free(jam);
-    sprite_free(logo);
+    if (frame_count > 0)
+        debugf("Menu: %ld frames, %ld layouts, %lld us of CPU per frame, %ld icon page uploads\n", frame_count, layout_count, TICKS_TO_US(frame_ticks/frame_count), icon_uploads);
+    if (text_layer != NULL)
+        rspq_block_free(text_layer);
+    rspq_block_free(background_layer);
+    core_asset_release(jam);
+    core_asset_release(icons);
+    core_asset_release(logo);
     rdpq_text_unregister_font(FONT_TEXT);
     rdpq_text_unregister_font(FONT_DEBUG);
-    rdpq_font_free(font);
+    core_asset_release(font);
     rdpq_font_free(fontdbg);
-    display_close();
     core_set_playercount(playercount);
     core_set_aidifficulty(ai_difficulty);
     #pragma GCC diagnostic push
     #pragma GCC diagnostic ignored "-Warray-bounds"
-    return global_minigame_list[sorted_indices[selected_minigame]].internalname;
+    return global_minigame_list[selected_minigame].internalname;
     #pragma GCC diagnostic pop
 }
@@ -25,6 +25,24 @@ static const char*  global_minigamepath = "rom:/minigames/";
 static const size_t global_minigamepath_len = 15;
 
 
+/*==============================
+    minigame_get_interface
+    Finds the interface table of a loaded minigame
+    @param  The handle of the minigame's dso
+    @param  The filename of the minigame, for errors
+    @return The interface, or NULL if the minigame 
+            doesn't have one
+==============================*/
+
+static const MinigameInterface* minigame_get_interface(void* handle, const char* filename)
+{
+    const MinigameInterface* iface = dlsym(handle, "minigame_interface");
+    if (iface != NULL)
+        assertf(iface->version == MINIGAME_INTERFACE_VERSION, "%s was built with minigame interface version %ld, expected %d\n", filename, iface->version, MINIGAME_INTERFACE_VERSION);
+    return iface;
+}
+
+
 /*==============================
     minigame_loadall
     Loads all the minigames from the filesystem
@@ -54,7 +72,8 @@ void minigame_loadall()
     do
     {
         void* handle;
-        MinigameDef* loadeddef;
+        const MinigameInterface* iface;
+        const MinigameDef* loadeddef;
         Minigame* newdef = &global_minigame_list[gamecount];
         char* filename = minigamesdir.d_name;
 
@@ -69,12 +88,22 @@ void minigame_loadall()
 
         // Get the symbols of the minigame definition. 
         // Since these symbols will only be temporarily stored in memory, we must make a deep copy
-        loadeddef = dlsym(handle, "minigame_def");
+        iface = minigame_get_interface(handle, filename);
+        if (iface != NULL)
+            loadeddef = iface->definition;
+        else
+            loadeddef = dlsym(handle, "minigame_def");
         assertf(loadeddef, "Unable to find symbol minigame_def in %s\n", filename);
         newdef->definition.gamename      = strdup(loadeddef->gamename);
         newdef->definition.developername = strdup(loadeddef->developername);
         newdef->definition.description   = strdup(loadeddef->description);
         newdef->definition.instructions  = strdup(loadeddef->instructions);
+        newdef->definition.display       = loadeddef->display;
+        newdef->definition.sfxvoices     = loadeddef->sfxvoices;
+        newdef->definition.systems       = loadeddef->systems;
+        newdef->definition.audiofrequency = loadeddef->audiofrequency;
+        newdef->definition.mixerchannels = loadeddef->mixerchannels;
+        newdef->definition.tickrate      = loadeddef->tickrate;
 
         // Set the internal name as the filename without the extension
         strrchr(filename, '.')[0] = '\0';
@@ -116,10 +145,29 @@ void minigame_play(char* name)
     sprintf(fullpath, "%s%s.dso", global_minigamepath, name);
     global_minigame_current->handle = dlopen(fullpath, RTLD_LOCAL);
 
-    global_minigame_current->funcPointer_init      = dlsym(global_minigame_current->handle, "minigame_init");
-    global_minigame_current->funcPointer_loop      = dlsym(global_minigame_current->handle, "minigame_loop");
-    global_minigame_current->funcPointer_fixedloop = dlsym(global_minigame_current->handle, "minigame_fixedloop");
-    global_minigame_current->funcPointer_cleanup   = dlsym(global_minigame_current->handle, "minigame_cleanup");
+    // Minigames with an interface table only need one lookup, older ones export each function
+    const MinigameInterface* iface = minigame_get_interface(global_minigame_current->handle, name);
+    if (iface != NULL)
+    {
+        global_minigame_current->funcPointer_init      = iface->init;
+        global_minigame_current->funcPointer_loop      = iface->loop;
+        global_minigame_current->funcPointer_fixedloop = iface->fixedloop;
+        global_minigame_current->funcPointer_cleanup   = iface->cleanup;
+    }
+    else
+    {
+        global_minigame_current->funcPointer_init      = dlsym(global_minigame_current->handle, "minigame_init");
+        global_minigame_current->funcPointer_loop      = dlsym(global_minigame_current->handle, "minigame_loop");
+        global_minigame_current->funcPointer_fixedloop = dlsym(global_minigame_current->handle, "minigame_fixedloop");
+        global_minigame_current->funcPointer_cleanup   = dlsym(global_minigame_current->handle, "minigame_cleanup");
+    }
+
+    // Measure the frame state from the minigame's side of the DSO boundary
+    #if CORE_FRAME_BENCHMARK
+        void (*framebench)(void) = dlsym(global_minigame_current->handle, "minigame_framebench");
+        if (framebench != NULL)
+            framebench();
+    #endif
 }
 
 
@@ -1,6 +1,8 @@
 #ifndef GAMEJAM2024_MINIGAME_H
 #define GAMEJAM2024_MINIGAME_H
 
+    #include "core.h"
+
     /***************************************************************
                        Public Minigame Constants
     ***************************************************************/
@@ -11,8 +13,59 @@
         char* developername;
         char* description;
         char* instructions;
+        CoreDisplayMode display; // Optional, leave it out to use the default display mode
+        uint32_t sfxvoices;      // Optional, how many sound effects can play at once (CORE_AUDIO_DEFAULTVOICES, or every mixer channel if there are fewer, if left out)
+        uint32_t systems;        // Optional, the CORE_SYSTEM_* flags of the subsystems you need (GL, Tiny3D)
+        uint32_t audiofrequency; // Optional, the audio frequency (CORE_AUDIO_FREQUENCY if left out)
+        uint32_t mixerchannels;  // Optional, how many mixer channels you need (CORE_AUDIO_CHANNELS if left out)
+        uint32_t tickrate;       // Optional, how many times per second minigame_fixedloop is called (TICKRATE if left out)
     } MinigameDef;
 
+    // Bump this whenever MinigameInterface or MinigameDef change
+    #define MINIGAME_INTERFACE_VERSION  3
+
+    // Everything the minigame manager needs from a minigame, found with a single symbol lookup
+    typedef struct {
+        uint32_t version;
+        const MinigameDef* definition;
+        void (*init)(void);
+        void (*fixedloop)(float deltatime);
+        void (*loop)(float deltatime);
+        void (*cleanup)(void);
+    } MinigameInterface;
+
+    // The minigame manager looks the interface up by name, so it needs C linkage even in C++,
+    // where a const at namespace scope would otherwise not be exported at all
+    #ifdef __cplusplus
+        #define MINIGAME_EXPORT  extern "C"
+    #else
+        #define MINIGAME_EXPORT  extern
+    #endif
+
+    // With "make FRAMEBENCH=1", every minigame also exports a frame state benchmark
+    #if CORE_FRAME_BENCHMARK
+        #define MINIGAME_FRAME_BENCHMARK(def) \
+            MINIGAME_EXPORT void minigame_framebench(void); \
+            void minigame_framebench(void) { core_frame_benchmark((def).gamename); }
+    #else
+        #define MINIGAME_FRAME_BENCHMARK(def)
+    #endif
+
+    // Declares your minigame's interface. Put this at the end of your main file, e.g:
+    // MINIGAME_INTERFACE(minigame_def, minigame_init, minigame_fixedloop, minigame_loop, minigame_cleanup);
+    // The fixed loop can be NULL if you don't need one
+    #define MINIGAME_INTERFACE(def, initfunc, fixedloopfunc, loopfunc, cleanupfunc) \
+        MINIGAME_FRAME_BENCHMARK(def) \
+        MINIGAME_EXPORT const MinigameInterface minigame_interface; \
+        const MinigameInterface minigame_interface = { \
+            .version = MINIGAME_INTERFACE_VERSION, \
+            .definition = &(def), \
+            .init = (initfunc), \
+            .fixedloop = (fixedloopfunc), \
+            .loop = (loopfunc), \
+            .cleanup = (cleanupfunc), \
+        }
+
 
     /***************************************************************
                        Public Minigame Functions
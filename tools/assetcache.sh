@@ -0,0 +1,74 @@
+#!/bin/sh
+# Runs an asset conversion through a cache keyed on the content of its inputs
+# and on the conversion command (tool, flags), so that unchanged assets are
+# restored instead of converted again after a clean or a branch switch.
+# Every call appends its time to a log, which "make asset-times" summarizes.
+#
+# Usage: assetcache.sh <output> <input>... -- <command>
+# ASSET_CACHE_DIR sets where the cache lives, ASSET_TIMES the log file.
+# ASSET_EXTRA is a glob of other files the command writes next to <output>
+# (like the pages of an atlas), which are cached and restored along with it.
+
+CACHE_DIR=${ASSET_CACHE_DIR:-.assetcache}
+TIMES=${ASSET_TIMES:-build/assettimes.log}
+
+content_hash() {
+    if command -v sha256sum > /dev/null; then
+        sha256sum | awk '{print $1}'
+    elif command -v shasum > /dev/null; then
+        shasum -a 256 | awk '{print $1}'
+    else
+        cksum | awk '{print $1 "-" $2}'
+    fi
+}
+
+now_ms() {
+    t=$(date +%s%N 2>/dev/null)
+    case "$t" in
+        *N) echo $(( $(date +%s) * 1000 )) ;;
+        *) echo $(( t / 1000000 )) ;;
+    esac
+}
+
+OUT=$1
+shift
+HASHES=""
+while [ $# -gt 0 ] && [ "$1" != "--" ]; do
+    HASHES="$HASHES $(content_hash < "$1")"
+    shift
+done
+shift
+CMD="$*"
+
+# A new version of the tool should invalidate its outputs too
+TOOL=$(echo "$CMD" | awk '{print $1}')
+TOOLID=""
+if [ -f "$TOOL" ]; then
+    TOOLID=$(ls -l "$TOOL" | awk '{print $5, $6, $7, $8}')
+fi
+KEY=$(printf '%s\n%s\n%s\n' "$HASHES" "$CMD" "$TOOLID" | content_hash)
+ENTRY="$CACHE_DIR/$KEY-$(basename "$OUT")"
+
+START=$(now_ms)
+if [ -n "$ASSET_EXTRA" ]; then
+    if [ -d "$ENTRY" ]; then
+        cp "$ENTRY"/* "$(dirname "$OUT")"
+        RESULT=hit
+    else
+        sh -c "$CMD" || exit $?
+        mkdir -p "$ENTRY.tmp.$$"
+        cp "$OUT" $ASSET_EXTRA "$ENTRY.tmp.$$" && mv "$ENTRY.tmp.$$" "$ENTRY"
+        RESULT=miss
+    fi
+elif [ -f "$ENTRY" ]; then
+    cp "$ENTRY" "$OUT"
+    RESULT=hit
+else
+    sh -c "$CMD" || exit $?
+    mkdir -p "$CACHE_DIR"
+    cp "$OUT" "$ENTRY.tmp.$$" && mv "$ENTRY.tmp.$$" "$ENTRY"
+    RESULT=miss
+fi
+
+mkdir -p "$(dirname "$TIMES")"
+echo "$(( $(now_ms) - START )) $RESULT $OUT" >> "$TIMES"
@@ -0,0 +1,381 @@
+// Host-side tool that packs small sprites (like the core button icons) into
+// texture atlas pages that each fit in TMEM.
+//
+// The smallest texture format whose RMS error stays within the quality
+// threshold is picked for the whole atlas. Every page is written as a
+// PNG named after that format (so mksprite converts it as is), together with
+// a lookup table telling where each icon is (see core_atlas.h for the layout).
+// Games can then draw any number of icons with one texture upload per page.
+//
+// Usage: atlaspack -o <output dir> -n <name> [-q <max RMS error>] <png>...
+// Only 8-bit, non-interlaced PNGs are supported. Needs zlib.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <zlib.h>
+
+#define MAX_ICONS      256
+#define NAME_LEN       24
+#define PAGEFILE_LEN   32
+#define TMEM_BYTES     4096
+
+typedef struct {
+    char name[NAME_LEN];
+    int width, height;
+    uint8_t *rgba;
+    int page, x, y;
+} Icon;
+
+typedef enum { FMT_I4, FMT_IA4, FMT_CI4, FMT_I8, FMT_IA8, FMT_CI8, FMT_IA16, FMT_RGBA16, FMT_RGBA32, FMT_COUNT } Format;
+
+// Sorted from the smallest to the biggest, the first one that passes is used
+static const char *format_names[FMT_COUNT] = { "i4", "ia4", "ci4", "i8", "ia8", "ci8", "ia16", "rgba16", "rgba32" };
+static const int format_bpp[FMT_COUNT] = { 4, 4, 4, 8, 8, 8, 16, 16, 32 };
+
+static Icon icons[MAX_ICONS];
+static int icon_count;
+
+static uint32_t read_u32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void write_u16(FILE *f, uint16_t v) {
+    uint8_t b[2] = { v >> 8, v };
+    fwrite(b, 1, 2, f);
+}
+
+static void write_u32(FILE *f, uint32_t v) {
+    uint8_t b[4] = { v >> 24, v >> 16, v >> 8, v };
+    fwrite(b, 1, 4, f);
+}
+
+static void fail(const char *fmt, const char *arg) {
+    fprintf(stderr, "atlaspack: ");
+    fprintf(stderr, fmt, arg);
+    fprintf(stderr, "\n");
+    exit(1);
+}
+
+static uint8_t paeth(int a, int b, int c) {
+    int p = a + b - c;
+    int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+    if (pa <= pb && pa <= pc) return a;
+    return (pb <= pc) ? b : c;
+}
+
+// Loads a PNG as 8-bit RGBA
+static uint8_t *load_png(const char *fn, int *width, int *height) {
+    FILE *f = fopen(fn, "rb");
+    if (!f) fail("can't open %s", fn);
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *file = malloc(size);
+    if (fread(file, 1, size, f) != (size_t)size) fail("can't read %s", fn);
+    fclose(f);
+    if (size < 8 || memcmp(file, "\x89PNG\r\n\x1a\n", 8)) fail("%s isn't a PNG", fn);
+
+    // Gather the header, palette and image data chunks
+    int w = 0, h = 0, depth = 0, type = 0, interlace = 0;
+    uint8_t palette[256][4];
+    uint8_t *idat = NULL;
+    size_t idat_size = 0;
+    for (int i = 0; i < 256; i++) palette[i][3] = 255;
+    for (long pos = 8; pos + 12 <= size;) {
+        uint32_t len = read_u32(file + pos);
+        const uint8_t *tag = file + pos + 4, *data = file + pos + 8;
+        if (pos + 12 + len > (uint32_t)size) fail("%s is truncated", fn);
+        if (!memcmp(tag, "IHDR", 4)) {
+            w = read_u32(data);
+            h = read_u32(data + 4);
+            depth = data[8];
+            type = data[9];
+            interlace = data[12];
+        } else if (!memcmp(tag, "PLTE", 4)) {
+            for (uint32_t i = 0; i < len/3; i++) {
+                palette[i][0] = data[i*3];
+                palette[i][1] = data[i*3+1];
+                palette[i][2] = data[i*3+2];
+            }
+        } else if (!memcmp(tag, "tRNS", 4) && type == 3) {
+            for (uint32_t i = 0; i < len && i < 256; i++) palette[i][3] = data[i];
+        } else if (!memcmp(tag, "IDAT", 4)) {
+            idat = realloc(idat, idat_size + len);
+            memcpy(idat + idat_size, data, len);
+            idat_size += len;
+        }
+        pos += 12 + len;
+    }
+    if (depth != 8 || interlace) fail("%s must be an 8-bit, non-interlaced PNG", fn);
+
+    int channels;
+    switch (type) {
+        case 0: channels = 1; break;
+        case 2: channels = 3; break;
+        case 3: channels = 1; break;
+        case 4: channels = 2; break;
+        case 6: channels = 4; break;
+        default: fail("%s has an unknown color type", fn); return NULL;
+    }
+
+    // Inflate and undo the per row filters
+    size_t stride = (size_t)w * channels;
+    uLongf raw_size = (stride + 1) * h;
+    uint8_t *raw = malloc(raw_size);
+    if (uncompress(raw, &raw_size, idat, idat_size) != Z_OK || raw_size != (stride + 1) * h)
+        fail("can't decompress %s", fn);
+    uint8_t *pixels = calloc(stride, h);
+    for (int y = 0; y < h; y++) {
+        const uint8_t *in = raw + y * (stride + 1) + 1;
+        uint8_t *out = pixels + y * stride, *up = y ? out - stride : NULL;
+        for (size_t x = 0; x < stride; x++) {
+            int a = x >= (size_t)channels ? out[x - channels] : 0;
+            int b = up ? up[x] : 0;
+            int c = (up && x >= (size_t)channels) ? up[x - channels] : 0;
+            switch (in[-1]) {
+                case 0: out[x] = in[x]; break;
+                case 1: out[x] = in[x] + a; break;
+                case 2: out[x] = in[x] + b; break;
+                case 3: out[x] = in[x] + (a + b) / 2; break;
+                case 4: out[x] = in[x] + paeth(a, b, c); break;
+                default: fail("%s has an unknown row filter", fn);
+            }
+        }
+    }
+
+    // Expand everything to RGBA
+    uint8_t *rgba = malloc((size_t)w * h * 4);
+    for (int i = 0; i < w * h; i++) {
+        const uint8_t *p = pixels + i * channels;
+        uint8_t *o = rgba + i * 4;
+        switch (type) {
+            case 0: o[0] = o[1] = o[2] = p[0]; o[3] = 255; break;
+            case 2: o[0] = p[0]; o[1] = p[1]; o[2] = p[2]; o[3] = 255; break;
+            case 3: memcpy(o, palette[p[0]], 4); break;
+            case 4: o[0] = o[1] = o[2] = p[0]; o[3] = p[1]; break;
+            case 6: memcpy(o, p, 4); break;
+        }
+    }
+    free(file);
+    free(idat);
+    free(raw);
+    free(pixels);
+    *width = w;
+    *height = h;
+    return rgba;
+}
+
+// Writes 8-bit RGBA pixels as a PNG
+static void write_chunk(FILE *f, const char *tag, const uint8_t *data, uint32_t len) {
+    uint32_t crc = crc32(0, (const uint8_t *)tag, 4);
+    crc = crc32(crc, data, len);
+    write_u32(f, len);
+    fwrite(tag, 1, 4, f);
+    fwrite(data, 1, len, f);
+    write_u32(f, crc);
+}
+
+static void save_png(const char *fn, const uint8_t *rgba, int w, int h) {
+    size_t stride = (size_t)w * 4;
+    uLongf raw_size = (stride + 1) * h, out_size = compressBound(raw_size);
+    uint8_t *raw = malloc(raw_size), *out = malloc(out_size);
+    for (int y = 0; y < h; y++) {
+        raw[y * (stride + 1)] = 0;
+        memcpy(raw + y * (stride + 1) + 1, rgba + y * stride, stride);
+    }
+    compress2(out, &out_size, raw, raw_size, 9);
+
+    uint8_t ihdr[13] = { w >> 24, w >> 16, w >> 8, w, h >> 24, h >> 16, h >> 8, h, 8, 6, 0, 0, 0 };
+    FILE *f = fopen(fn, "wb");
+    if (!f) fail("can't write %s", fn);
+    fwrite("\x89PNG\r\n\x1a\n", 1, 8, f);
+    write_chunk(f, "IHDR", ihdr, sizeof(ihdr));
+    write_chunk(f, "IDAT", out, out_size);
+    write_chunk(f, "IEND", NULL, 0);
+    fclose(f);
+    free(raw);
+    free(out);
+}
+
+// Reduces an 8-bit value to the given number of bits and expands it back
+static int requant(int v, int bits) {
+    int max = (1 << bits) - 1;
+    return ((v * max + 127) / 255) * 255 / max;
+}
+
+// Converts a pixel to what the format can store. Intensity formats
+// use the intensity as alpha too.
+static void convert_pixel(Format fmt, const uint8_t *in, uint8_t *out) {
+    int i = (in[0] + in[1] + in[2]) / 3;
+    switch (fmt) {
+        case FMT_I4:   out[0] = out[1] = out[2] = out[3] = requant(i, 4); break;
+        case FMT_I8:   out[0] = out[1] = out[2] = out[3] = i; break;
+        case FMT_IA4:  out[0] = out[1] = out[2] = requant(i, 3); out[3] = requant(in[3], 1); break;
+        case FMT_IA8:  out[0] = out[1] = out[2] = requant(i, 4); out[3] = requant(in[3], 4); break;
+        case FMT_IA16: out[0] = out[1] = out[2] = i; out[3] = in[3]; break;
+        case FMT_CI4: case FMT_CI8: case FMT_RGBA16:
+            // The palettes are RGBA16 too
+            out[0] = requant(in[0], 5); out[1] = requant(in[1], 5); out[2] = requant(in[2], 5);
+            out[3] = requant(in[3], 1);
+            break;
+        default: memcpy(out, in, 4); break;
+    }
+}
+
+// Measures how far off converting every icon to a format is, as the RMS error of
+// the alpha premultiplied channels (so colors under transparent pixels don't count)
+static double format_error(Format fmt) {
+    uint32_t colors[256];
+    int color_count = 0, max_colors = (fmt == FMT_CI4) ? 16 : 256;
+    double sum = 0;
+    long samples = 0;
+    for (int n = 0; n < icon_count; n++) {
+        for (int i = 0; i < icons[n].width * icons[n].height; i++) {
+            const uint8_t *in = icons[n].rgba + i * 4;
+            uint8_t out[4];
+            convert_pixel(fmt, in, out);
+            for (int c = 0; c < 4; c++) {
+                double a = (c == 3) ? in[3] : in[c] * in[3] / 255.0;
+                double b = (c == 3) ? out[3] : out[c] * out[3] / 255.0;
+                sum += (a - b) * (a - b);
+                samples++;
+            }
+
+            // Palette formats only work if the colors fit
+            if (fmt == FMT_CI4 || fmt == FMT_CI8) {
+                uint32_t color = ((uint32_t)out[0] << 24) | (out[1] << 16) | (out[2] << 8) | out[3];
+                int c;
+                for (c = 0; c < color_count && colors[c] != color; c++);
+                if (c == color_count) {
+                    if (color_count == max_colors) return 255;
+                    colors[color_count++] = color;
+                }
+            }
+        }
+    }
+    return sqrt(sum / samples);
+}
+
+static int icon_sort(const void *a, const void *b) {
+    const Icon *ia = a, *ib = b;
+    if (ia->height != ib->height) return ib->height - ia->height;
+    return strcmp(ia->name, ib->name);
+}
+
+int main(int argc, char *argv[]) {
+    const char *outdir = NULL, *name = NULL;
+    double quality = 4.0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-o") && i+1 < argc) outdir = argv[++i];
+        else if (!strcmp(argv[i], "-n") && i+1 < argc) name = argv[++i];
+        else if (!strcmp(argv[i], "-q") && i+1 < argc) quality = atof(argv[++i]);
+        else if (argv[i][0] == '-') fail("unknown option %s", argv[i]);
+        else {
+            if (icon_count == MAX_ICONS) fail("too many icons, the limit is %s", "256");
+            Icon *icon = &icons[icon_count++];
+            const char *base = strrchr(argv[i], '/') ? strrchr(argv[i], '/') + 1 : argv[i];
+            snprintf(icon->name, NAME_LEN, "%.*s", (int)strcspn(base, "."), base);
+            icon->rgba = load_png(argv[i], &icon->width, &icon->height);
+        }
+    }
+    if (!outdir || !name || icon_count == 0) {
+        fprintf(stderr, "Usage: atlaspack -o <output dir> -n <name> [-q <max RMS error>] <png>...\n");
+        return 1;
+    }
+
+    // Pick the smallest format that looks good enough
+    Format fmt = FMT_RGBA32;
+    for (int f = 0; f < FMT_RGBA32; f++) {
+        if (format_error(f) <= quality) {
+            fmt = f;
+            break;
+        }
+    }
+
+    // Palette formats keep their palette in the upper half of TMEM, and so does RGBA32 with its alpha
+    int page_bytes = (fmt == FMT_CI4 || fmt == FMT_CI8) ? TMEM_BYTES/2 : TMEM_BYTES;
+    int page_texels = page_bytes * 8 / format_bpp[fmt];
+    int max_w = 0, max_h = 0;
+    for (int n = 0; n < icon_count; n++) {
+        if (icons[n].width > max_w) max_w = icons[n].width;
+        if (icons[n].height > max_h) max_h = icons[n].height;
+    }
+    int page_w = 16;
+    while (page_w * page_w * 2 <= page_texels) page_w *= 2;
+    while (page_w < max_w) page_w *= 2;
+    int page_h = page_texels / page_w;
+    if (page_w * max_h > page_texels) {
+        fprintf(stderr, "atlaspack: %dx%d icons don't fit in TMEM as %s\n", max_w, max_h, format_names[fmt]);
+        return 1;
+    }
+
+    // Shelf pack the tallest icons first
+    qsort(icons, icon_count, sizeof(Icon), icon_sort);
+    int page_count = 1, shelf_x = 0, shelf_y = 0, shelf_h = 0;
+    int used_h[MAX_ICONS] = {0};
+    for (int n = 0; n < icon_count; n++) {
+        Icon *icon = &icons[n];
+        if (shelf_x + icon->width > page_w) {
+            shelf_y += shelf_h;
+            shelf_x = shelf_h = 0;
+        }
+        if (shelf_y + icon->height > page_h) {
+            page_count++;
+            shelf_x = shelf_y = shelf_h = 0;
+        }
+        icon->page = page_count - 1;
+        icon->x = shelf_x;
+        icon->y = shelf_y;
+        shelf_x += icon->width;
+        if (icon->height > shelf_h) shelf_h = icon->height;
+        if (shelf_y + shelf_h > used_h[icon->page]) used_h[icon->page] = shelf_y + shelf_h;
+    }
+
+    // Write the pages, trimmed to the rows they use
+    char fn[4096], pagefile[MAX_ICONS][PAGEFILE_LEN] = {{0}};
+    for (int p = 0; p < page_count; p++) {
+        int h = 1;
+        while (h < used_h[p]) h *= 2;
+        uint8_t *rgba = calloc((size_t)page_w * h, 4);
+        for (int n = 0; n < icon_count; n++) {
+            if (icons[n].page != p) continue;
+            for (int y = 0; y < icons[n].height; y++)
+                for (int x = 0; x < icons[n].width; x++)
+                    convert_pixel(fmt, icons[n].rgba + (y * icons[n].width + x) * 4,
+                                  rgba + ((icons[n].y + y) * page_w + icons[n].x + x) * 4);
+        }
+        snprintf(pagefile[p], PAGEFILE_LEN, "%s%d.%s.sprite", name, p, format_names[fmt]);
+        snprintf(fn, sizeof(fn), "%s/%s%d.%s.png", outdir, name, p, format_names[fmt]);
+        save_png(fn, rgba, page_w, h);
+        free(rgba);
+    }
+
+    // Write the lookup table
+    snprintf(fn, sizeof(fn), "%s/%s.atlas", outdir, name);
+    FILE *f = fopen(fn, "wb");
+    if (!f) fail("can't write %s", fn);
+    fwrite("ATLS", 1, 4, f);
+    write_u16(f, page_count);
+    write_u16(f, icon_count);
+    for (int p = 0; p < page_count; p++)
+        fwrite(pagefile[p], 1, PAGEFILE_LEN, f);
+    for (int n = 0; n < icon_count; n++) {
+        fwrite(icons[n].name, 1, NAME_LEN, f);
+        write_u16(f, icons[n].page);
+        write_u16(f, icons[n].x);
+        write_u16(f, icons[n].y);
+        write_u16(f, icons[n].width);
+        write_u16(f, icons[n].height);
+        write_u16(f, 0);
+    }
+    fclose(f);
+
+    printf("%d icons in %d %dx%d %s page(s), RMS error %.2f\n", icon_count, page_count, page_w, page_h,
+           format_names[fmt], format_error(fmt));
+    return 0;
+}
@@ -0,0 +1,59 @@
+#!/bin/sh
+# Prints the code/data size, the imported symbol count and the relocations of
+# every minigame DSO.
+#
+# Usage: dsoreport.sh [--check <max imports> <max reloc bytes>] <build dir> <dso dir> <minigame>...
+# N64_SIZE, N64_READELF and N64_NM must point to the toolchain's size, readelf and nm.
+# With --check, the script fails if a DSO goes over the limits or doesn't export
+# a minigame_interface table.
+
+CHECK=0
+if [ "$1" = "--check" ]; then
+    CHECK=1
+    MAX_IMPORTS=$2
+    MAX_RELOCBYTES=$3
+    shift 3
+fi
+BUILD_DIR=$1
+DSO_DIR=$2
+shift 2
+
+FAILED=0
+printf "%-20s %10s %10s %10s %10s %8s %8s %11s\n" "minigame" "text" "data" "bss" "dso file" "imports" "relocs" "reloc bytes"
+for game in "$@"; do
+    # The DSO is linked from an ELF named after the minigame somewhere in the build folder
+    elf=$(find "$BUILD_DIR" -name "$game.elf" -o -name "$game.dso.elf" | head -n 1)
+    dso="$DSO_DIR/$game.dso"
+    if [ -z "$elf" ] || [ ! -f "$dso" ]; then
+        printf "%-20s (not built)\n" "$game"
+        continue
+    fi
+    sizes=$($N64_SIZE -B "$elf" | tail -n 1)
+    text=$(echo "$sizes" | awk '{print $1}')
+    data=$(echo "$sizes" | awk '{print $2}')
+    bss=$(echo "$sizes" | awk '{print $3}')
+    imports=$($N64_NM -u "$elf" | wc -l)
+    relocs=$($N64_READELF -r "$elf" | grep -c "R_MIPS_")
+    relocbytes=0
+    for size in $($N64_READELF -S -W "$elf" | sed 's/^ *\[ *[0-9]*\]//' | awk '$1 ~ /^\.rela?\./ { print $5 }'); do
+        relocbytes=$((relocbytes + 0x$size))
+    done
+    dsosize=$(wc -c < "$dso")
+    printf "%-20s %10d %10d %10d %10d %8d %8d %11d\n" "$game" "$text" "$data" "$bss" "$dsosize" "$imports" "$relocs" "$relocbytes"
+
+    if [ $CHECK -eq 1 ]; then
+        if [ "$imports" -gt "$MAX_IMPORTS" ]; then
+            echo "  $game imports $imports symbols, the limit is $MAX_IMPORTS"
+            FAILED=1
+        fi
+        if [ "$relocbytes" -gt "$MAX_RELOCBYTES" ]; then
+            echo "  $game has $relocbytes bytes of relocations, the limit is $MAX_RELOCBYTES"
+            FAILED=1
+        fi
+        if ! $N64_NM "$elf" | grep -q " minigame_interface$"; then
+            echo "  $game doesn't declare a MINIGAME_INTERFACE"
+            FAILED=1
+        fi
+    fi
+done
+exit $FAILED
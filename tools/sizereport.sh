@@ -0,0 +1,152 @@
+#!/bin/sh
+# Prints what every minigame costs in the ROM: the bytes its assets take in the
+# filesystem (as stored and once decompressed) and the code/data/bss of its
+# DSO. Files at the root of the filesystem and in its core folder are counted
+# as "core".
+#
+# Usage: sizereport.sh <build dir> <filesystem dir> <dso dir> <baseline file> <minigame>...
+#
+# N64_SIZE must point to the toolchain's size. If MKASSET points to mkasset,
+# every uncompressed asset is also compressed at each level to suggest the one
+# that loads fastest, using ROM_KBPS and DECOMP_KBPS_1..3 as the read and
+# decompression speeds (in KB/s).
+#
+# With SIZE_UPDATE_BASELINE=1 the totals are written to the baseline file.
+# Otherwise they are compared against it, and the script fails if a minigame
+# grew by more than SIZE_TOLERANCE percent.
+
+BUILD_DIR=$1
+FS_DIR=$2
+DSO_DIR=$3
+BASELINE=$4
+shift 4
+
+SIZE_TOLERANCE=${SIZE_TOLERANCE:-2}
+ROM_KBPS=${ROM_KBPS:-5000}
+DECOMP_KBPS_1=${DECOMP_KBPS_1:-8000}
+DECOMP_KBPS_2=${DECOMP_KBPS_2:-2500}
+DECOMP_KBPS_3=${DECOMP_KBPS_3:-300}
+
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+# Prints the compression level, stored size and raw size of an asset.
+# Compressed assets start with a "DCA" header holding both sizes.
+asset_sizes() {
+    stored=$(wc -c < "$1")
+    set -- $(od -A n -t x1 -N 16 "$1")
+    if [ "$1$2$3" = "444341" ] && [ $# -eq 16 ]; then
+        echo "$((0x$5$6)) $stored $((0x${13}${14}${15}${16}))"
+    else
+        echo "0 $stored $stored"
+    fi
+}
+
+# Estimated time in microseconds to read and decompress an asset
+load_us() {
+    level=$1; stored=$2; raw=$3
+    us=$((stored * 1000 / ROM_KBPS))
+    case $level in
+        1) us=$((us + raw * 1000 / DECOMP_KBPS_1)) ;;
+        2) us=$((us + raw * 1000 / DECOMP_KBPS_2)) ;;
+        3) us=$((us + raw * 1000 / DECOMP_KBPS_3)) ;;
+    esac
+    echo $us
+}
+
+# Sums the assets in a list of files into the per-game totals, and writes
+# the per-asset suggestions to the side
+sum_assets() {
+    files=0; stored_total=0; raw_total=0
+    for f in $(cat); do
+        set -- $(asset_sizes "$f")
+        level=$1; stored=$2; raw=$3
+        files=$((files + 1))
+        stored_total=$((stored_total + stored))
+        raw_total=$((raw_total + raw))
+
+        # Try every level on uncompressed assets, compressed ones can only be
+        # compared against storing them raw
+        best=$level
+        best_us=$(load_us "$level" "$stored" "$raw")
+        if [ "$level" -eq 0 ] && [ -n "$MKASSET" ]; then
+            for try in 1 2 3; do
+                rm -rf "$TMP/c" && mkdir -p "$TMP/c"
+                "$MKASSET" -c $try -o "$TMP/c" "$f" > /dev/null 2>&1 || continue
+                trysize=$(wc -c < "$TMP/c/$(basename "$f")")
+                tryus=$(load_us $try "$trysize" "$raw")
+                if [ "$tryus" -lt "$best_us" ]; then
+                    best=$try
+                    best_us=$tryus
+                fi
+            done
+        elif [ "$level" -ne 0 ]; then
+            rawus=$(load_us 0 "$raw" "$raw")
+            if [ "$rawus" -lt "$best_us" ]; then
+                best=0
+                best_us=$rawus
+            fi
+        fi
+        printf "%-48s %5d %10d %10d %5d %9d %9d\n" "$f" "$level" "$stored" "$raw" "$best" \
+            "$(load_us "$level" "$stored" "$raw")" "$best_us" >> "$TMP/assets"
+    done
+    echo "$files $stored_total $raw_total"
+}
+
+FAILED=0
+: > "$TMP/assets"
+: > "$TMP/totals"
+printf "%-16s %6s %10s %10s %10s %10s %10s %10s %10s  %s\n" "minigame" "files" "dfs" "dfs raw" "dso file" "text" "data" "bss" "total" "vs baseline"
+for game in core "$@"; do
+    if [ "$game" = "core" ]; then
+        assets=$( (find "$FS_DIR" -maxdepth 1 -type f; find "$FS_DIR/core" -type f 2>/dev/null) | sort | sum_assets)
+        dsosize=0; text=0; data=0; bss=0
+    else
+        assets=$( (find "$FS_DIR/$game" -type f 2>/dev/null || true) | sort | sum_assets)
+        elf=$(find "$BUILD_DIR" -name "$game.elf" -o -name "$game.dso.elf" | head -n 1)
+        dso="$DSO_DIR/$game.dso"
+        dsosize=0; text=0; data=0; bss=0
+        if [ -n "$elf" ] && [ -f "$dso" ]; then
+            dsosize=$(wc -c < "$dso")
+            sizes=$($N64_SIZE -B "$elf" | tail -n 1)
+            text=$(echo "$sizes" | awk '{print $1}')
+            data=$(echo "$sizes" | awk '{print $2}')
+            bss=$(echo "$sizes" | awk '{print $3}')
+        fi
+    fi
+    files=$(echo "$assets" | awk '{print $1}')
+    stored=$(echo "$assets" | awk '{print $2}')
+    raw=$(echo "$assets" | awk '{print $3}')
+    total=$((stored + dsosize))
+    echo "$game $total" >> "$TMP/totals"
+
+    # Compare the ROM footprint against the baseline
+    delta=""
+    if [ -f "$BASELINE" ] && [ "$SIZE_UPDATE_BASELINE" != "1" ]; then
+        old=$(awk -v g="$game" '$1 == g { print $2 }' "$BASELINE")
+        if [ -z "$old" ]; then
+            delta="new"
+        else
+            delta=$(printf "%+d" $((total - old)))
+            if [ $((total * 100)) -gt $((old * (100 + SIZE_TOLERANCE))) ]; then
+                delta="$delta REGRESSED"
+                FAILED=1
+            fi
+        fi
+    fi
+    printf "%-16s %6d %10d %10d %10d %10d %10d %10d %10d  %s\n" "$game" "$files" "$stored" "$raw" "$dsosize" "$text" "$data" "$bss" "$total" "$delta"
+done
+
+echo
+printf "%-48s %5s %10s %10s %5s %9s %9s\n" "asset" "level" "stored" "raw" "best" "load us" "best us"
+cat "$TMP/assets"
+
+if [ "$SIZE_UPDATE_BASELINE" = "1" ]; then
+    cp "$TMP/totals" "$BASELINE"
+    echo
+    echo "Baseline written to $BASELINE"
+elif [ ! -f "$BASELINE" ]; then
+    echo
+    echo "No baseline yet, run 'make size-baseline' to create one"
+fi
+exit $FAILED
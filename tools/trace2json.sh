@@ -0,0 +1,50 @@
+#!/bin/sh
+# Converts the trace dumped by core_trace_dump into the Chrome trace event
+# format, which chrome://tracing and ui.perfetto.dev can open.
+#
+# Usage: trace2json.sh <debug log> > trace.json
+# Only the last dump in the log is converted. Spans that were cut in half by
+# the ring buffer wrapping around are dropped at the start, and closed at the
+# last event at the end, innermost first.
+
+awk '
+/^TRACE-BEGIN/ { n = 0; intrace = 1; next }
+/^TRACE-END/   { intrace = 0; next }
+intrace && $1 == "TRACE" {
+    name = $5
+    for (i = 6; i <= NF; i++) name = name " " $i
+    gsub(/\\/, "\\\\", name)
+    gsub(/"/, "\\\"", name)
+    ph[n] = $2; ts[n] = $3; val[n] = $4; nm[n] = name
+    n++
+}
+END {
+    printf "{\"traceEvents\":[\n"
+    sep = ""
+    last = 0
+    depth = 0
+    for (i = 0; i < n; i++) {
+        last = ts[i]
+        if (ph[i] == "B") {
+            open[depth++] = nm[i]
+        } else if (ph[i] == "E") {
+            # Ends whose begin was lost to the wraparound have nothing to close
+            for (j = depth - 1; j >= 0 && open[j] != nm[i]; j--);
+            if (j < 0) continue
+            for (; j < depth - 1; j++) open[j] = open[j + 1]
+            depth--
+        }
+        if (ph[i] == "C")
+            printf "%s{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%s,\"pid\":0,\"tid\":0,\"args\":{\"value\":%s}}", sep, nm[i], ts[i], val[i]
+        else if (ph[i] == "i")
+            printf "%s{\"name\":\"%s\",\"ph\":\"i\",\"ts\":%s,\"pid\":0,\"tid\":0,\"s\":\"g\"}", sep, nm[i], ts[i]
+        else
+            printf "%s{\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%s,\"pid\":0,\"tid\":0}", sep, nm[i], ph[i], ts[i]
+        sep = ",\n"
+    }
+    while (depth > 0) {
+        printf "%s{\"name\":\"%s\",\"ph\":\"E\",\"ts\":%s,\"pid\":0,\"tid\":0}", sep, open[--depth], last
+        sep = ",\n"
+    }
+    printf "\n]}\n"
+}' "$1"